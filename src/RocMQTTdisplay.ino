@@ -58,6 +58,7 @@ https://github.com/chrisweather/RocMQTTdisplay/wiki
 #include <string>
 #include <Wire.h>
 #include <time.h>
+#include <stddef.h>
 #if defined(ESP8266)           // ESP8266
 #include <ESP8266WiFi.h>       // 
 #elif defined(ESP32)           // ESP32
@@ -71,6 +72,9 @@ https://github.com/chrisweather/RocMQTTdisplay/wiki
 #include "config.h"            // Roc-MQTT-Display configuration file
 #include "template.h"          // Roc-MQTT-Display template file
 #include "web.h"               // Roc-MQTT-Display web file
+#include "zzamsg.h"            // Roc-MQTT-Display ZZAMSG parser
+#include "rrclock.h"           // Roc-MQTT-Display railroad clock parser
+#include "metrics.h"           // Roc-MQTT-Display timing statistics
 //#include <ArduinoOTA.h>        // ArduinoOTA by Juraj Andrassy https://github.com/jandrassy/ArduinoOTA
 #include <EspMQTTClient.h>     // EspMQTTClient by Patrick Lapointe https://github.com/plapointe6/EspMQTTClient
 #define _TASK_TIMECRITICAL     // TaskScheduler by Anatoli Arkhipenko https://github.com/arkhipenko/TaskScheduler
@@ -117,177 +121,237 @@ U8G2_SSD1316_128X32_F_HW_I2C disp(U8G2_R0, U8X8_PIN_NONE);
 
 // ##################################################################
 
-u8g2_uint_t offset1 = 0;  // current offset for the scrolling text
-u8g2_uint_t offset2 = 0;
-u8g2_uint_t offset3 = 0;
-u8g2_uint_t offset4 = 0;
-u8g2_uint_t offset5 = 0;
-u8g2_uint_t offset6 = 0;
-u8g2_uint_t offset7 = 0;
-u8g2_uint_t offset8 = 0;
-u8g2_uint_t width1 =  0;  // pixel width of the scrolling text (must be < 128 unless U8G2_16BIT is defined, max display 240x240, https://github.com/olikraus/u8g2/wiki/u8g2setupcpp#16-bit-mode)
-u8g2_uint_t width2 =  0;
-u8g2_uint_t width3 =  0;
-u8g2_uint_t width4 =  0;
-u8g2_uint_t width5 =  0;
-u8g2_uint_t width6 =  0;
-u8g2_uint_t width7 =  0;
-u8g2_uint_t width8 =  0;
+// Field sizes of the display state, longer fields are truncated at a UTF-8 character boundary
+#define ZZA_IDSLEN   33            // Targets, room for 8 display IDs
+#define ZZA_NAMELEN  41            // Station, Destination
+#define ZZA_SHORTLEN 21            // Departure, Train
+#define ZZA_TRACKLEN 8             // Track
+#define ZZA_TYPELEN  LOGOIDLEN     // TrainType, longer types have no logo, see logoId[] in template.h and logodir in config.h
+#define ZZA_MSGLEN   201           // Message
+#define ZZA_MSGSEGS  9             // Message segments, room for 4 variables, more variables are shown as received
+#define ZZA_DEPSEGS  3             // Departure segments, room for 1 variable
+
+// Compiled templates, the fields a template shows as a short list of draw operations, built from the TPL_* settings by compileTemplates()
+#define TPLOPS 8                   // max. draw operations of a template
+enum { OP_TEXT, OP_TICKER, OP_LOGO };
+struct TplOp {
+  uint8_t  code;                   // OP_*
+  uint8_t  font;                   // OP_TEXT, font number
+  uint8_t  font2;                  // OP_TEXT, font for text wider than maxwidth
+  uint8_t  maxwidth;               // OP_TEXT, 0 = no width check
+  uint8_t  minlen;                 // OP_TEXT, shorter texts are not drawn
+  uint8_t  center;                 // OP_TEXT, 1 = x is the center of the text
+  uint16_t text;                   // OP_TEXT, offset of the text in DisplayState
+  int16_t  x;
+  int16_t  y;
+};
+struct TplDraw {
+  uint8_t  fontmode;               // font mode and draw color of all fields (TPL_6fontmode, TPL_6drawcolor)
+  uint8_t  drawcolor;
+  uint8_t  count;                  // number of draw operations
+  TplOp    op[TPLOPS];
+};
+TplDraw tplDraw[10];               // Templates T0 - T9
+
+// Content of one display, fixed size buffers to keep the heap unfragmented
+struct DisplayState {
+  char     Targets[ZZA_IDSLEN];        // Display IDs of the last message, e.g. D01D02
+  uint8_t  Template;                   // Template number 0-9
+  char     Station[ZZA_NAMELEN];       // Station name
+  char     Track[ZZA_TRACKLEN];        // Track number
+  char     Destination[ZZA_NAMELEN];   // Destination name
+  char     DepartureO[ZZA_SHORTLEN];   // Departure time as received, may contain {rrtime}
+  char     Departure[ZZA_SHORTLEN];    // Departure time with variables replaced
+  char     Train[ZZA_SHORTLEN];        // Train number
+  char     Type[ZZA_TYPELEN];          // Train type for logo selection
+  uint16_t logo;                       // logo handle of Type, LOGO_NONE = no logo
+  char     MessageO[ZZA_MSGLEN];       // Message as received, may contain {ntptime}, {ntpdate}, {rrtime}, {rrdate}
+  char     Message[ZZA_MSGLEN];        // Message with variables replaced
+  char     MessageLoop[ZZA_MSGLEN+5]; // " +++ " + Message, used for the scrolling ticker
+  u8g2_uint_t offset;                  // current offset for the scrolling text
+  u8g2_uint_t width;                   // pixel width of the scrolling text (must be < 128 unless U8G2_16BIT is defined, max display 240x240, https://github.com/olikraus/u8g2/wiki/u8g2setupcpp#16-bit-mode)
+  uint16_t version;                    // incremented whenever the displayed content changes
+  uint16_t drawnVersion;               // content version currently shown on the display
+  uint32_t framesSent;                 // statistics, frames drawn and sent to the display
+  uint32_t framesSkipped;              // statistics, frames skipped because nothing changed
+  uint32_t bytesSent;                  // statistics, frame buffer bytes sent to the display
+  uint32_t framesDeferred;             // statistics, frames postponed because the render budget was used up
+  uint32_t fpsFrames;                  // statistics, framesSent at the start of the fps interval
+  uint16_t fpsX10;                     // statistics, frames per second * 10 in the last fps interval
+  unsigned long lastDraw;              // millis() of the last frame, displays drawn least recently go first
+  unsigned long lastScrollUs;          // micros() of the last scrolling frame, 0 = last frame was not scrolling
+  uint32_t drawUs;                     // statistics, time spent drawing into the frame buffer
+  uint32_t sendUs;                     // statistics, time spent sending the frame buffer
+  VarSeg   msgSegs[ZZA_MSGSEGS];       // MessageO compiled into literals and variables
+  VarSeg   depSegs[ZZA_DEPSEGS];       // DepartureO compiled into literals and variables
+  uint8_t  msgSegCount;
+  uint8_t  depSegCount;
+  uint8_t  vars;                       // variables used by the message and departure, VAR_*
+  uint16_t stripPos;                   // ticker cache, start of the pre-rendered message in tickerPool
+  uint16_t stripLen;                   // ticker cache, size in bytes, 0 = message is rendered live
+  uint16_t stripVersion;               // ticker cache, content version of the pre-rendered message
+  uint8_t  stripTpl;                   // ticker cache, template of the pre-rendered message
+  uint8_t  stripRow;                   // ticker cache, first tile row of the message
+  uint8_t  stripRows;                  // ticker cache, number of tile rows
+  uint16_t layoutVersion;              // layout cache, content version of layoutFont and layoutX
+  uint8_t  layoutTpl;                  // layout cache, template of layoutFont and layoutX
+  uint8_t  layoutFont[TPLOPS];         // layout cache, font of every draw operation
+  int16_t  layoutX[TPLOPS];            // layout cache, x position of every draw operation
+};
+DisplayState ZZA[MAXDISP];         // Displays 1-MAXDISP
+
+// I2C bus layer, remembers the selected multiplexer port and the controller settings of every panel.
+// Commands that would change nothing are not sent.
+struct PanelState {
+  int8_t   invert;                 // last sent settings, -1 = unknown
+  int8_t   flip;
+  int16_t  contrast;
+  int8_t   power;
+  uint32_t i2cTransactions;        // statistics, I2C transfers to this display incl. multiplexer selection
+  uint32_t i2cBytes;               // statistics, bytes sent in these transfers
+};
+PanelState panel[MAXDISP];
+int16_t muxPort = -1;              // display selected at the multiplexer, -1 = unknown
+uint8_t muxAddr = 0;               // multiplexer with a selected port, 0 = unknown
+u8x8_msg_cb busByteCb = nullptr;   // I2C byte callback of the display driver
+
+// Display ID lookup, rebuilt when DPL_id changes
+static_assert(MAXDISP <= 32, "DispMask has room for 32 displays");
+DisplayId dplIds[MAXDISP];
+uint8_t   dplIdCount = 0;
+
+// Inbound message queue, the MQTT callback only queues received messages, send2display() applies them to the displays.
+// A newer message for a display replaces the queued one, only the newest pending message per display is kept.
+#define MSGQUEUE MAXDISP           // queued messages, with one per display no message is dropped, when full the oldest is dropped
+#define MSGQLEN  (ZZA_IDSLEN + 4 + 2 * ZZA_NAMELEN + ZZA_TRACKLEN + 2 * ZZA_SHORTLEN + ZZA_TYPELEN + ZZA_MSGLEN)
+const uint16_t msgFieldLen[ZZAF_COUNT] = { ZZA_IDSLEN, 4, ZZA_NAMELEN, ZZA_TRACKLEN, ZZA_NAMELEN, ZZA_SHORTLEN, ZZA_SHORTLEN, ZZA_TYPELEN, ZZA_MSGLEN, 0, 0 };
+struct QueuedMsg {
+  DispMask targets;                // displays still waiting for this message, 0 = replaced by newer messages
+  ZZAMsg   msg;                    // fields, point into buf
+  char     buf[MSGQLEN];           // fields cut to the size of the display state
+};
+QueuedMsg msgQueue[MSGQUEUE];
+uint8_t   msgHead = 0;             // oldest queued message
+uint8_t   msgCount = 0;
+struct MsgStats {
+  uint32_t payloads;               // MQTT payloads received, a batch carries several messages
+  uint32_t enqueued;               // messages queued
+  uint32_t coalesced;              // messages replaced by newer messages before they were shown
+  uint32_t dropped;                // messages dropped because the queue was full, or by the router when larger than an MQTT packet
+  uint8_t  highWater;              // most messages queued at the same time
+  uint32_t forwarded;              // router, messages published to the display topics
+  uint32_t rateFrom;               // enqueued at the start of the rate interval
+  uint16_t rateX10;                // messages per second * 10 in the last rate interval
+} msgStats;
+
+// Router, the messages of a payload are collected and forwarded together, the fields point into the payload
+ZZAMsg  routeMsg[MSGQUEUE];
+uint8_t routeCount = 0;
+
+// Ticker cache, scrolling messages are rendered once and copied into the frame buffer with every frame.
+// Messages that don't fit into the pool are rendered live with every frame.
+#define TICKERPOOL 3072            // bytes shared by all displays, one byte per pixel column and tile row (8 pixel rows)
+uint8_t  tickerPool[TICKERPOOL];
+uint16_t tickerUsed = 0;
+bool     tickerOk = false;         // frame buffer layout supports the ticker cache
+
+uint32_t glyphsDrawn = 0;          // characters drawn by drawText(), see /bench
 
 // Define TaskScheduler 
 Scheduler ts;
 
+// Timing statistics of tasks and callbacks, always on, see /metrics
+enum { TM_CORE, TM_DISPLAYS, TM_UPDVAR, TM_RMNET, TM_CLOCK, TM_ZZAMSG, TM_SCROLL, TM_RENDER };   // TM_RENDER + i = display i+1
+#define TM_COUNT (TM_RENDER + MAXDISP)
+const char *timingName[TM_RENDER] = { "coreLoop", "send2display", "updVar", "mqttRmnet", "mqttClock", "mqttZzamsg", "scrollInterval" };
+TaskTiming timing[TM_COUNT];
+
+// Flash and RAM used by every class of static assets and buffers, known at build time except for the logo files
+enum { AS_LOGOS, AS_FONTNAMES, AS_SETTINGS, AS_DRAWLISTS, AS_DISPLAYS, AS_QUEUE, AS_TICKER, AS_TIMING, AS_COUNT };
+struct AssetUse {
+  const char *name;
+  uint32_t flash;                  // bytes read in place from flash
+  uint32_t ram;                    // bytes of RAM
+} assetUse[AS_COUNT];
+
+// Locks, with RENDERTASK the displays are drawn on the other core while loop() receives messages.
+// The draw lock is held by the render task for a whole pass of send2display(). It guards the displays, the I2C bus and
+// ZZA[], loop() takes it only to draw itself or to change templates, logos and display settings.
+// The state lock is held only for short copies: the message queue, the time and date variables, the screen saver
+// request, the boot timeline and the timing statistics. Take the draw lock first.
+#if defined(ESP32) && RENDERTASK == 1
+SemaphoreHandle_t drawLock = NULL;
+SemaphoreHandle_t stateLock = NULL;
+#endif
+struct DrawLock {
+  DrawLock() {
+    #if defined(ESP32) && RENDERTASK == 1
+      xSemaphoreTakeRecursive(drawLock, portMAX_DELAY);
+    #endif
+  }
+  ~DrawLock() {
+    #if defined(ESP32) && RENDERTASK == 1
+      xSemaphoreGiveRecursive(drawLock);
+    #endif
+  }
+};
+struct StateLock {
+  StateLock() {
+    #if defined(ESP32) && RENDERTASK == 1
+      xSemaphoreTakeRecursive(stateLock, portMAX_DELAY);
+    #endif
+  }
+  ~StateLock() {
+    #if defined(ESP32) && RENDERTASK == 1
+      xSemaphoreGiveRecursive(stateLock);
+    #endif
+  }
+};
+
+// Measures the run time of the enclosing block
+struct TimingScope {
+  TaskTiming &m;
+  unsigned long t0;
+  TimingScope(TaskTiming &m) : m(m), t0(micros()) {}
+  ~TimingScope() { StateLock lock; timingAdd(m, micros() - t0); }
+};
+
 // TaskScheduler - Callback methods prototypes
 void coreLoop();
 void sendConfiguration();
-void send2display1();
-void send2display2();
-void send2display3();
-void send2display4();
-void send2display5();
-void send2display6();
-void send2display7();
-void send2display8();
+void send2display();
 void DemoModeOn();
 void DemoTimeOn();
-void updVar();
 
 // TaskScheduler - Tasks
 Task tSc(100, TASK_FOREVER, &coreLoop, &ts, true);                         // Core Loop
 Task tS0(180000, TASK_FOREVER, &sendConfiguration, &ts, true);             // share RMD configuration via MQTT
-Task tS1(60 + config.UPDSPEED, TASK_FOREVER, &send2display1, &ts, true);   // Display 1
-Task tS2(60 + config.UPDSPEED, TASK_FOREVER, &send2display2, &ts, false);  // Display 2
-Task tS3(60 + config.UPDSPEED, TASK_FOREVER, &send2display3, &ts, false);  // Display 3
-Task tS4(60 + config.UPDSPEED, TASK_FOREVER, &send2display4, &ts, false);  // Display 4
-Task tS5(60 + config.UPDSPEED, TASK_FOREVER, &send2display5, &ts, false);  // Display 5
-Task tS6(60 + config.UPDSPEED, TASK_FOREVER, &send2display6, &ts, false);  // Display 6
-Task tS7(60 + config.UPDSPEED, TASK_FOREVER, &send2display7, &ts, false);  // Display 7
-Task tS8(60 + config.UPDSPEED, TASK_FOREVER, &send2display8, &ts, false);  // Display 8
+Task tSd(60 + config.UPDSPEED, TASK_FOREVER, &send2display, &ts, false);   // Displays
 Task tS9(8000, 15, &DemoModeOn, &ts, false);                               // Demo Mode
 Task tS10(2000, TASK_FOREVER, &DemoTimeOn, &ts, false);                    // Demo Time
-Task tS11(10000, TASK_FOREVER, &updVar, &ts, false);                       // NTP Time/Date only, when no railroad time available
 
 // Define WIFI/MQTT Client
 EspMQTTClient client(sec.WIFI_SSID, sec.WIFI_PW, config.MQTT_IP, sec.MQTT_USER, sec.MQTT_PW, config.WIFI_DEVICENAME, config.MQTT_PORT);
 
 // Define global variables
 unsigned long lastMsg = 0;         // ScreenSaver
+uint8_t screenOff = 0;             // ScreenSaver, power save mode requested for all displays, send2display() switches them
 unsigned long lastNTP = 0;         // NTP
 time_t now;
 tm tm;
 uint8_t demonum =   1;             // Demo Mode
 uint8_t demomin =   12;
-String ntptime =    "00:00";       // NTP Time/Date
-String ntpdate =    "01.01.2000";  
-String rrtime =     "00:00";       // Railroad Time/Date
-String rrtimelast = "00:00";
-String rrdate =     "01.01.2000";
-String rrdatelast = "01.01.2000";
+char ntptime[12] =  "00:00";       // NTP Time/Date
+char ntpdate[12] =  "01.01.2000";
+char rrtime[12] =   "00:00";       // Railroad Time/Date
+char rrdate[12] =   "01.01.2000";
+const char *const varValues[4] = { rrtime, rrdate, ntptime, ntpdate };  // in the order of varName[]
+char varLast[4][16];               // values of the variables in the displayed messages
 String RMDcfg =     "";            // RMnet
-
-String ZZA1_Targets =     "";
-String ZZA1_Template =    "";
-String ZZA1_Station =     "";
-String ZZA1_Track =       "";
-String ZZA1_Destination = "";
-String ZZA1_DepartureO =  "";
-String ZZA1_Departure =   "";
-String ZZA1_Train =       "";
-String ZZA1_Type =        "";
-String ZZA1_MessageO =    "";
-String ZZA1_Message =     "";
-String ZZA1_MessageLoop = "";
-
-String ZZA2_Targets =     "";
-String ZZA2_Template =    "";
-String ZZA2_Station =     "";
-String ZZA2_Track =       "";
-String ZZA2_Destination = "";
-String ZZA2_DepartureO =  "";
-String ZZA2_Departure =   "";
-String ZZA2_Train =       "";
-String ZZA2_Type =        "";
-String ZZA2_MessageO =    "";
-String ZZA2_Message =     "";
-String ZZA2_MessageLoop = "";
-
-String ZZA3_Targets =     "";
-String ZZA3_Template =    "";
-String ZZA3_Station =     "";
-String ZZA3_Track =       "";
-String ZZA3_Destination = "";
-String ZZA3_DepartureO =  "";
-String ZZA3_Departure =   "";
-String ZZA3_Train =       "";
-String ZZA3_Type =        "";
-String ZZA3_MessageO =    "";
-String ZZA3_Message =     "";
-String ZZA3_MessageLoop = "";
-
-String ZZA4_Targets =     "";
-String ZZA4_Template =    "";
-String ZZA4_Station =     "";
-String ZZA4_Track =       "";
-String ZZA4_Destination = "";
-String ZZA4_DepartureO =  "";
-String ZZA4_Departure =   "";
-String ZZA4_Train =       "";
-String ZZA4_Type =        "";
-String ZZA4_MessageO =    "";
-String ZZA4_Message =     "";
-String ZZA4_MessageLoop = "";
-
-String ZZA5_Targets =     "";
-String ZZA5_Template =    "";
-String ZZA5_Station =     "";
-String ZZA5_Track =       "";
-String ZZA5_Destination = "";
-String ZZA5_DepartureO =  "";
-String ZZA5_Departure =   "";
-String ZZA5_Train =       "";
-String ZZA5_Type =        "";
-String ZZA5_MessageO =    "";
-String ZZA5_Message =     "";
-String ZZA5_MessageLoop = "";
-
-String ZZA6_Targets =     "";
-String ZZA6_Template =    "";
-String ZZA6_Station =     "";
-String ZZA6_Track =       "";
-String ZZA6_Destination = "";
-String ZZA6_DepartureO =  "";
-String ZZA6_Departure =   "";
-String ZZA6_Train =       "";
-String ZZA6_Type =        "";
-String ZZA6_MessageO =    "";
-String ZZA6_Message =     "";
-String ZZA6_MessageLoop = "";
-
-String ZZA7_Targets =     "";
-String ZZA7_Template =    "";
-String ZZA7_Station =     "";
-String ZZA7_Track =       "";
-String ZZA7_Destination = "";
-String ZZA7_DepartureO =  "";
-String ZZA7_Departure =   "";
-String ZZA7_Train =       "";
-String ZZA7_Type =        "";
-String ZZA7_MessageO =    "";
-String ZZA7_Message =     "";
-String ZZA7_MessageLoop = "";
-
-String ZZA8_Targets =     "";
-String ZZA8_Template =    "";
-String ZZA8_Station =     "";
-String ZZA8_Track =       "";
-String ZZA8_Destination = "";
-String ZZA8_DepartureO =  "";
-String ZZA8_Departure =   "";
-String ZZA8_Train =       "";
-String ZZA8_Type =        "";
-String ZZA8_MessageO =    "";
-String ZZA8_Message =     "";
-String ZZA8_MessageLoop = "";
+#define BOOTDEFER 30000              // ms, deferred boot work runs at the latest this long after the start
+bool bootDeferred = false;         // fast boot: saving configuration, snapshot and debug dumps waits for the first shown message
+bool bootSave = false;             // fast boot: configuration and snapshot are still to be saved
+bool bootShown = false;            // first message was shown on a display
 
 
 // SETUP, runs once at startup
@@ -296,6 +360,7 @@ void setup()
   Serial.begin(115200);
   while (!Serial) continue;
   delay(500);
+  bootMark("serial", micros());
 
   Serial.println(F("\n\n\nStarting Roc-MQTT-Display..."));
 
@@ -304,108 +369,96 @@ void setup()
     Serial.println(F("LittleFS Mount Failed"));
     return;
   }
+  bootMark("littlefs", micros());
 
   TPL = 0;
   // Load sec from file
   Serial.print(F("\nLoading sec from \n"));
   Serial.println(secfile);
   loadSecData(secfile, sec);
+  bootMark("sec", micros());
 
-  // Load config from file
-  Serial.print(F("\nLoading configuration from \n"));
-  Serial.println(configfile);
-  loadConfiguration(configfile, config);
-
-  // Save config to file
-  Serial.print(F("\nSaving configuration to \n"));
-  Serial.println(configfile);
-  saveConfiguration(configfile, config);
-
-  //Read display width and height from display constructor
-  config.DISPWIDTH = disp.getDisplayWidth();
-  config.DISPHEIGHT = disp.getDisplayHeight();
-  
-  // Load template data from file
-  Serial.print(F("\nLoading template data from \n"));
-  Serial.println(templatefile);
-  //loadTemplate(templatefile, templ);
-  loadTemplate(templatefile);
-
-  // Load template0x from file
-  Serial.print(F("\nLoading templates from \n"));
-  TPL = 0;
-  Serial.println(template00);
-  loadTemplateFile(template00);
-  TPL = 1;
-  Serial.println(template01);
-  loadTemplateFile(template01);
-  TPL = 2;
-  Serial.println(template02);
-  loadTemplateFile(template02);
-  TPL = 3;
-  Serial.println(template03);
-  loadTemplateFile(template03);
-  TPL = 4;  
-  Serial.println(template04);
-  loadTemplateFile(template04);
-  TPL = 5;
-  Serial.println(template05);
-  loadTemplateFile(template05);
-  TPL = 6;
-  Serial.println(template06);
-  loadTemplateFile(template06);
-  TPL = 7;
-  Serial.println(template07);
-  loadTemplateFile(template07);
-  TPL = 8;
-  Serial.println(template08);
-  loadTemplateFile(template08);
-  TPL = 9;
-  Serial.println(template09);
-  loadTemplateFile(template09);
-  TPL = 0;
-
-  if (config.MQTT_DEBUG == 1){
-    // Dump configuration files
-    Serial.print(F("\nPrint "));
-    Serial.println(secfile);
-    printFile(secfile);
-    Serial.print(F("\nPrint "));
+  // Load config and templates from the snapshot, from the json files when the snapshot is missing or outdated
+  if (loadSnapshot()){
+    Serial.print(F("\nLoaded configuration and templates from \n"));
+    Serial.println(snapfile);
+  }
+  else {
+    // Load config from file
+    Serial.print(F("\nLoading configuration from \n"));
     Serial.println(configfile);
-    printFile(configfile);
-    Serial.print(F("\nPrint "));
+    loadConfiguration(configfile, config);
+
+    // Save config to file, in fast boot after the first message is shown
+    bootSave = (config.FASTBOOT == 1);
+    bootDeferred = bootSave;
+    if (!bootSave){
+      Serial.print(F("\nSaving configuration to \n"));
+      Serial.println(configfile);
+      saveConfiguration(configfile, config);
+    }
+
+    // Load template data from file
+    Serial.print(F("\nLoading template data from \n"));
     Serial.println(templatefile);
-    printFile(templatefile);
-    Serial.print(F("\nPrint "));
+    //loadTemplate(templatefile, templ);
+    loadTemplate(templatefile);
+
+    // Load template0x from file
+    Serial.print(F("\nLoading templates from \n"));
+    TPL = 0;
     Serial.println(template00);
-    printFile(template00);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template00);
+    TPL = 1;
     Serial.println(template01);
-    printFile(template01);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template01);
+    TPL = 2;
     Serial.println(template02);
-    printFile(template02);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template02);
+    TPL = 3;
     Serial.println(template03);
-    printFile(template03);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template03);
+    TPL = 4;  
     Serial.println(template04);
-    printFile(template04);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template04);
+    TPL = 5;
     Serial.println(template05);
-    printFile(template05);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template05);
+    TPL = 6;
     Serial.println(template06);
-    printFile(template06);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template06);
+    TPL = 7;
     Serial.println(template07);
-    printFile(template07);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template07);
+    TPL = 8;
     Serial.println(template08);
-    printFile(template08);
-    Serial.print(F("\nPrint "));
+    loadTemplateFile(template08);
+    TPL = 9;
     Serial.println(template09);
-    printFile(template09);
+    loadTemplateFile(template09);
+    TPL = 0;
+
+    // Save the snapshot for the next boot
+    if (!bootSave){
+      Serial.print(F("\nSaving snapshot to \n"));
+      Serial.println(snapfile);
+      saveSnapshot();
+    }
+  }
+  bootMark("config", micros());
+  buildDisplayIds();
+  loadLogos();
+  printAssets();
+
+  //Read display width and height from display constructor
+  config.DISPWIDTH = disp.getDisplayWidth();
+  config.DISPHEIGHT = disp.getDisplayHeight();
+
+  if (config.MQTT_DEBUG == 1 && config.FASTBOOT == 1){
+    bootDeferred = true;
+  }
+  else if (config.MQTT_DEBUG == 1){
+    dumpFiles();
   }
 
   // Switch off Wemos D1 mini onboard LED
@@ -419,9 +472,13 @@ void setup()
   if (strlen(config.MQTT_IP) < 7) {
     Serial.println(F("\nWARNING: MQTT broker IP-adress is missing or incomplete in CONFIGURATION"));
   }
+  if (config.NUMDISP > MAXDISP){
+    config.NUMDISP = MAXDISP;
+  }
   Serial.print(F("\n  Displays enabled: "));
   Serial.print(config.NUMDISP);
-  Serial.println(F(" / 8"));
+  Serial.print(F(" / "));
+  Serial.println(MAXDISP);
   Serial.print(F("  Display pixel resolution: "));
   Serial.print(config.DISPWIDTH);
   Serial.print(F(" x "));
@@ -524,25 +581,38 @@ void setup()
 
   webserver.on("/submitcfg", []() {    // Define the handling function for the /submitcfg path
     webserver.send(204);
+    DrawLock draw;
     handleCfgSubmit();
+    buildDisplayIds();
+    loadLogos();
+    resolveLogos();
+    redrawAll();
     loadCfg();
   });
 
   webserver.on("/submittpl1", []() {   // Define the handling function for the /submittpl1 path
     webserver.send(204);
+    DrawLock draw;
     handleTpl1Submit();
+    loadLogos();
+    resolveLogos();
+    redrawAll();
     loadTpl1();
   });
 
   webserver.on("/submittpl2", []() {   // Define the handling function for the /submittpl2 path
     webserver.send(204);
+    DrawLock draw;
     handleTpl2Submit();
+    redrawAll();
     loadTpl2();
   });
 
   webserver.on("/submittpl2imp", []() {   // Define the handling function for the /submittpl2imp path
     webserver.send(204);
+    DrawLock draw;
     handleTpl2impSubmit();
+    redrawAll();
   });
 
   webserver.on("/submitsec", []() {    // Define the handling function for the /submitsec path
@@ -562,6 +632,14 @@ void setup()
     config.PRINTBUF = 1;
   });
 
+  webserver.on("/bench", []() {        // Define the handling function for the /bench path
+    handleBench();
+  });
+
+  webserver.on("/metrics", []() {      // Define the handling function for the /metrics path
+    webserver.send(200, "application/json", metricsJson(false));
+  });
+
   webserver.on("/restart", []() {      // Define the handling function for the /restart path
     webserver.send(204);
     yield();
@@ -614,7 +692,7 @@ void setup()
         }
       } else if (upload.status == UPLOAD_FILE_END) {
         if (Update.end(true)) { //true to set the size to the current progress
-          Serial.printf("Update Success: %u\nRebooting...\n", upload.totalSize);
+          Serial.printf("Update Success: %u\nRebooting...\n", (unsigned int)upload.totalSize);
         } else {
           Update.printError(Serial);
         }
@@ -633,24 +711,86 @@ void setup()
 
   // Initialize all connected displays
   if (config.MUX == 0){
-    tS1.setInterval(65 + config.UPDSPEED);
-    tS2.disable();
-    tS3.disable();
-    tS4.disable();
-    tS5.disable();
-    tS6.disable();
-    tS7.disable();
-    tS8.disable();
+    tSd.setInterval(65 + config.UPDSPEED);
+  }
+  else {
+    tSd.setInterval(60 + config.UPDSPEED);
   }
 
   if(config.MUX > 0){
     Wire.begin();
   }
+  bootMark("network", micros());
   DisplayInit();
+  bootMark("displays", micros());
 
 } // End of SETUP
 
 
+// Dump configuration files
+void dumpFiles()
+{
+  Serial.print(F("\nPrint "));
+  Serial.println(secfile);
+  printFile(secfile);
+  Serial.print(F("\nPrint "));
+  Serial.println(configfile);
+  printFile(configfile);
+  Serial.print(F("\nPrint "));
+  Serial.println(templatefile);
+  printFile(templatefile);
+  Serial.print(F("\nPrint "));
+  Serial.println(template00);
+  printFile(template00);
+  Serial.print(F("\nPrint "));
+  Serial.println(template01);
+  printFile(template01);
+  Serial.print(F("\nPrint "));
+  Serial.println(template02);
+  printFile(template02);
+  Serial.print(F("\nPrint "));
+  Serial.println(template03);
+  printFile(template03);
+  Serial.print(F("\nPrint "));
+  Serial.println(template04);
+  printFile(template04);
+  Serial.print(F("\nPrint "));
+  Serial.println(template05);
+  printFile(template05);
+  Serial.print(F("\nPrint "));
+  Serial.println(template06);
+  printFile(template06);
+  Serial.print(F("\nPrint "));
+  Serial.println(template07);
+  printFile(template07);
+  Serial.print(F("\nPrint "));
+  Serial.println(template08);
+  printFile(template08);
+  Serial.print(F("\nPrint "));
+  Serial.println(template09);
+  printFile(template09);
+}
+
+
+// Fast boot: work that was deferred until the first message is shown, or BOOTDEFER ms at the latest
+void bootFinish()
+{
+  bootDeferred = false;
+  if (bootSave){
+    bootSave = false;
+    Serial.print(F("\nSaving configuration to \n"));
+    Serial.println(configfile);
+    saveConfiguration(configfile, config);
+    Serial.print(F("\nSaving snapshot to \n"));
+    Serial.println(snapfile);
+    saveSnapshot();
+  }
+  if (config.MQTT_DEBUG == 1){
+    dumpFiles();
+  }
+}
+
+
 // Restart the controller
 void restartESP()
 {
@@ -660,1313 +800,1325 @@ void restartESP()
 }
 
 
-// Switch between Displays with I2C Multiplexer TCA9548A
+// Switch between Displays with I2C Multiplexer TCA9548A, nothing is sent if the port is already selected
+// Displays 9-16 are connected to a second multiplexer at address MUX + 1, and so on
 void DMUX(uint8_t port)
 {
-  Wire.beginTransmission( config.MUX );  // TCA9548A default address is 0x70
-  Wire.write( 1 << port );               // Send byte to select display port
-  Wire.endTransmission();
+  if (port == muxPort){
+    return;
+  }
+  uint8_t mux = config.MUX + (port / 8);
+  uint8_t error = 0;
+  if (mux != muxAddr && muxAddr != 0){
+    // All displays use the same address, disconnect the ports of the previous multiplexer
+    Wire.beginTransmission( muxAddr );
+    Wire.write( 0 );
+    error = Wire.endTransmission();
+    panel[port].i2cTransactions++;
+    panel[port].i2cBytes += 2;
+  }
+  Wire.beginTransmission( mux );         // TCA9548A default address is 0x70
+  Wire.write( 1 << (port % 8) );         // Send byte to select display port
+  error |= Wire.endTransmission();
+  panel[port].i2cTransactions++;
+  panel[port].i2cBytes += 2;
+  if (error != 0){
+    // Selection unknown, select again with the next transfer
+    muxAddr = 0;
+    muxPort = -1;
+    return;
+  }
+  muxAddr = mux;
+  muxPort = port;
 }
 
 
-// Initialize all connected displays
-void DisplayInit()
+// Counts the I2C transfers of the display driver for the selected display
+uint8_t busCountCb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  // Loop through all connected displays on the I2C bus
-  for (uint8_t i = 0; i < config.NUMDISP; i++) {
-    switch (i){
-    case 0: tS1.enable();
-            break;
-    case 1: tS2.enable();
-            break;
-    case 2: tS3.enable();
-            break;
-    case 3: tS4.enable();
-            break;
-    case 4: tS5.enable();
-            break;
-    case 5: tS6.enable();
-            break;
-    case 6: tS7.enable();
-            break;
-    case 7: tS8.enable();
-            break;
-    }
-    if (config.MUX > 0){
-      DMUX(i);
-    }
-    //disp.setBusClock(400000);  // I2C bus speed, default 100000, changes might impact bus/display speed and reduce stability, experimental
+  PanelState &p = panel[muxPort >= 0 ? muxPort : 0];
+  if (msg == U8X8_MSG_BYTE_START_TRANSFER){
+    p.i2cTransactions++;
+    p.i2cBytes++;                        // device address
+  }
+  else if (msg == U8X8_MSG_BYTE_SEND){
+    p.i2cBytes += arg_int;
+  }
+  return busByteCb(u8x8, msg, arg_int, arg_ptr);
+}
+
+
+// Install the I2C counter and forget the panel settings, call before the displays are initialized
+void busInit()
+{
+  if (busByteCb == nullptr){
+    busByteCb = disp.getU8x8()->byte_cb;
+    disp.getU8x8()->byte_cb = busCountCb;
+  }
+  muxPort = -1;
+  muxAddr = 0;
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    panel[i].invert = -1;
+    panel[i].flip = -1;
+    panel[i].contrast = -1;
+    panel[i].power = -1;
+  }
+}
+
+
+// Select display i, only needed with multiplexer
+void panelSelect(uint8_t i)
+{
+  if (config.MUX > 0){
+    DMUX(i);
+  }
+}
+
+
+// Invert display i (selected), 0 = normal, 1 = inverted
+void panelInvert(uint8_t i, uint8_t invert)
+{
+  if (panel[i].invert != invert){
+    disp.sendF("c", invert == 1 ? 0x0a7 : 0x0a6);
+    panel[i].invert = invert;
+  }
+}
+
+
+// Flip mode of display i (selected)
+// setFlipMode() also sets the x offset of the display driver, which all displays share. When display i is flipped already
+// only the offset is set for it, the previous display may have used the other flip mode.
+void panelFlip(uint8_t i, uint8_t flip)
+{
+  if (panel[i].flip != flip){
+    disp.setFlipMode(flip);
+    panel[i].flip = flip;
+  }
+  else {
+    u8x8_t *u8x8 = disp.getU8x8();
+    u8x8->x_offset = (flip == 1) ? u8x8->display_info->flipmode_x_offset : u8x8->display_info->default_x_offset;
+  }
+}
+
+
+// Contrast of display i (selected)
+void panelContrast(uint8_t i, uint8_t contrast)
+{
+  if (panel[i].contrast != contrast){
+    disp.setContrast(contrast);
+    panel[i].contrast = contrast;
+  }
+}
 
+
+// Power save mode of display i, 1 = display off
+void panelPower(uint8_t i, uint8_t power)
+{
+  if (panel[i].power != power){
+    panelSelect(i);
+    disp.setPowerSave(power);
+    panel[i].power = power;
+  }
+}
+
+
+// Fast boot: start all displays first, then show one combined start screen on all of them at the same time
+void DisplayInitFast()
+{
+  for (uint8_t i = 0; i < config.NUMDISP; i++) {
+    panelSelect(i);
     disp.begin();
+    panelFlip(i, DPL_flip[i]);
+    panelContrast(i, DPL_contrast[i]);
+    disp.enableUTF8Print();
+  }
+  bool broker = strlen(config.MQTT_IP) >= 7;
+  for (uint8_t i = 0; i < config.NUMDISP; i++) {
+    panelSelect(i);
+    panelFlip(i, DPL_flip[i]);
     disp.firstPage();
     do {
-      //disp.begin();  // Initialize display i
-      disp.setFlipMode(DPL_flip[i]);
-      disp.setContrast(DPL_contrast[i]);
-      //if (DPL_contrast[i] == 0){
-      //  disp.setPowerSave(1);
-      //}
-      //else {
-      //  disp.setPowerSave(0);
-      //}
-      //disp.nextPage();
-      disp.enableUTF8Print();
       disp.setFont(fontno[5]);
       disp.setFontMode(0);
       disp.setCursor(0,7);
-      disp.print(F("Roc-MQTT-Display "));
-      disp.setCursor(0,15);
-      disp.print(config.VER);
-      disp.nextPage();
-      delay(100 + (config.STARTDELAY / 2));
-      disp.clearDisplay();
-      disp.setFont(fontno[5]);
-      disp.setCursor(0,7);
-      disp.print(F("http://"));
-      disp.setCursor(0,15);
-      disp.print(config.WIFI_DEVICENAME);
-      disp.nextPage();
-      delay(100 + (config.STARTDELAY / 2));
-      disp.clearDisplay();
-      disp.setCursor(0,7);
       disp.print(F("Display: "));
       disp.print(i+1);
-      disp.setCursor(0,15);
-      disp.print(F("ID: "));
+      disp.print(F("  ID: "));
       disp.print(DPL_id[i]);
+      disp.setCursor(0,15);
+      if (broker){
+        disp.print(config.WIFI_DEVICENAME);
+        disp.print(F(" "));
+        disp.print(config.VER);
+      }
+      else {
+        disp.print(F("NO MQTT broker"));
+      }
+    } while (disp.nextPage());
+    Serial.print(F("  Display: "));
+    Serial.print(i+1);
+    Serial.print(F("  connected to multiplexer port (SCx, SDx): "));
+    Serial.print(i);
+    Serial.print(F("  Display-ID: "));
+    Serial.println(DPL_id[i]);
+  }
+  if (!broker){
+    delay(5000);
+  }
+}
 
-      if (strlen(config.MQTT_IP) < 7) {
+
+// Initialize all connected displays
+void DisplayInit()
+{
+  #if defined(ESP32) && RENDERTASK == 1
+    drawLock = xSemaphoreCreateRecursiveMutex();
+    stateLock = xSemaphoreCreateRecursiveMutex();
+  #endif
+  // Loop through all connected displays on the I2C bus
+  busInit();
+  if (config.FASTBOOT == 1){
+    DisplayInitFast();
+  }
+  else {
+    for (uint8_t i = 0; i < config.NUMDISP; i++) {
+      panelSelect(i);
+      //disp.setBusClock(400000);  // I2C bus speed, default 100000, changes might impact bus/display speed and reduce stability, experimental
+
+      disp.begin();
+      disp.firstPage();
+      do {
+        //disp.begin();  // Initialize display i
+        panelFlip(i, DPL_flip[i]);
+        panelContrast(i, DPL_contrast[i]);
+        //if (DPL_contrast[i] == 0){
+        //  disp.setPowerSave(1);
+        //}
+        //else {
+        //  disp.setPowerSave(0);
+        //}
+        //disp.nextPage();
+        disp.enableUTF8Print();
+        disp.setFont(fontno[5]);
+        disp.setFontMode(0);
+        disp.setCursor(0,7);
+        disp.print(F("Roc-MQTT-Display "));
+        disp.setCursor(0,15);
+        disp.print(config.VER);
         disp.nextPage();
         delay(100 + (config.STARTDELAY / 2));
         disp.clearDisplay();
+        disp.setFont(fontno[5]);
         disp.setCursor(0,7);
-        disp.print(F("NO MQTT broker"));
+        disp.print(F("http://"));
         disp.setCursor(0,15);
-        disp.print(F("Check Config!"));
+        disp.print(config.WIFI_DEVICENAME);
         disp.nextPage();
-        delay(5000 + (config.STARTDELAY / 2));
-      }
-      Serial.print(F("  Display: "));
-      Serial.print(i+1);
-      Serial.print(F("  connected to multiplexer port (SCx, SDx): "));
-      Serial.print(i);
-      Serial.print(F("  Display-ID: "));
-      Serial.println(DPL_id[i]);
-    } while (disp.nextPage());
+        delay(100 + (config.STARTDELAY / 2));
+        disp.clearDisplay();
+        disp.setCursor(0,7);
+        disp.print(F("Display: "));
+        disp.print(i+1);
+        disp.setCursor(0,15);
+        disp.print(F("ID: "));
+        disp.print(DPL_id[i]);
+
+        if (strlen(config.MQTT_IP) < 7) {
+          disp.nextPage();
+          delay(100 + (config.STARTDELAY / 2));
+          disp.clearDisplay();
+          disp.setCursor(0,7);
+          disp.print(F("NO MQTT broker"));
+          disp.setCursor(0,15);
+          disp.print(F("Check Config!"));
+          disp.nextPage();
+          delay(5000 + (config.STARTDELAY / 2));
+        }
+        Serial.print(F("  Display: "));
+        Serial.print(i+1);
+        Serial.print(F("  connected to multiplexer port (SCx, SDx): "));
+        Serial.print(i);
+        Serial.print(F("  Display-ID: "));
+        Serial.println(DPL_id[i]);
+      } while (disp.nextPage());
+    }
   }
   Serial.println(F(""));
   delay(config.STARTDELAY);
+  tickerInit();
+  redrawAll();
+  #if defined(ESP32) && RENDERTASK == 1
+    // Draw the displays on the core that doesn't run loop()
+    xTaskCreatePinnedToCore(renderTask, "render", 8192, NULL, 1, NULL, 1 - xPortGetCoreID());
+  #else
+    tSd.enable();
+  #endif
 }
 
 
-// TaskScheduler callback methods 1-8
-
-// *** Write to Display 1 ***
-void send2display1(void)
+#if defined(ESP32) && RENDERTASK == 1
+// Render task, runs send2display() with the interval of tSd
+void renderTask(void *param)
 {
-  if (config.MQTT_DEBUG == 1){
-    Serial.print(F(" tS1: overrun = "));
-    Serial.println(tS1.getOverrun());
-    //Serial.print(F(", start delayed by "));
-    //Serial.println(tS1.getStartDelay());
-  }
-  // Template number
-  uint8_t t = ZZA1_Template.toInt();  //!!!!!!!!!!!!!!-> init, statt String direkt uint8_t
-  if (t > 9){
-    t = 0;
-  }
-  if (DPL_side[0] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
+  TickType_t last = xTaskGetTickCount();
+  for (;;){
+    {
+      DrawLock draw;
+      send2display();
     }
+    vTaskDelayUntil(&last, pdMS_TO_TICKS(tSd.getInterval()));
   }
-  if (config.MUX > 0){
-    DMUX(0);
-  }
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
+}
+#endif
+
+
+// Force a redraw of all displays, e.g. after configuration or template changes
+void redrawAll()
+{
+  DrawLock draw;
+  compileTemplates();
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    ZZA[i].version++;
   }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[0]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA1_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA1_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA1_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA1_Message);
-    }
+}
+
+
+// True if text drawn at baseline y with font f can be seen on the display
+bool textVisible(uint8_t f, int y)
+{
+  disp.setFont(fontno[f]);
+  return y - disp.getDescent() >= 0 && y - disp.getAscent() < config.DISPHEIGHT;
+}
+
+
+// Add a text field to the draw list of template t, fields outside the display are left out
+void compileText(uint8_t t, uint16_t text, uint8_t font, uint8_t font2, uint8_t maxwidth, uint8_t minlen, uint8_t center, int x, int y)
+{
+  TplDraw &d = tplDraw[t];
+  if (maxwidth == 0){
+    // Without a max. width every text is drawn with font 2
+    font = font2;
   }
-  else {
-    // *** Scrolling message ***
-    if (ZZA1_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width1 = disp.getUTF8Width(ZZA1_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        // draw message box
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        // draw black box
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset1;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA1_MessageLoop.c_str());
-        x += width1;
-      //} while( x < disp.getDisplayWidth());
-      } while( x < config.DISPWIDTH);
-    }
+  if (d.count >= TPLOPS || (!textVisible(font, y) && !textVisible(font2, y))){
+    return;
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
+  d.op[d.count++] = { OP_TEXT, font, font2, maxwidth, minlen, center, text, (int16_t)x, (int16_t)y };
+}
+
 
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  //Serial.println(ZZA1_Station);
-  //if (int a = ZZA1_Station.indexOf("\n") != -1){
-    //Serial.println("line break");
-    //Serial.println(a);
-  //}
-  //int start09 = start08 + 1 + pld.substring(start08).indexOf("#");
-  
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA1_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
-  }
-  //disp.setCursor((disp.getDisplayWidth() / 2) - (disp.getUTF8Width(ZZA2_Station.c_str()) / 2), TPL_3posy[t]);
-  //disp.drawUTF8(TPL_0posx[t], TPL_0posy[t], ZZA2_Station.c_str());
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA1_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA1_Station.c_str());
-
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA1_Track);
-
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA1_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
-  }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA1_Destination.c_str());
-
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA1_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA1_Departure);
-
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA1_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA1_Train);
-
-  // Logo
-  if ( ZZA1_Type != "" ) {
-    switchLogo(t, ZZA1_Type);
-  }
-
-/*  int l = ZZA1_Logo;
-    
-    switch (l){ 
-      //case 1: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], switchLogo(ZZA1_Logo));
-      case 1: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl1);
-              break;
-      case 2: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl2);
-              break;
-      case 3: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo3);
-              break;
-      case 4: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl4);
-              break;
-      case 5: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl5);
-              break;
-      case 6: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo6);
-              break;
-      case 7: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl7);
-              break;
-      case 8: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], *pl8);
-              break;
-      case 9: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo9);
+// Compile the TPL_* settings of all templates into draw lists, in the order drawFrame() used to draw the fields
+void compileTemplates()
+{
+  for (uint8_t t = 0; t < 10; t++){
+    TplDraw &d = tplDraw[t];
+    d.count = 0;
+    // All fields are drawn with the font mode and color of the message
+    d.fontmode = TPL_6fontmode[t];
+    d.drawcolor = TPL_6drawcolor[t];
+    if (TPL_6scroll[t] == 1){
+      d.op[d.count++] = { OP_TICKER, 0, 0, 0, 0, 0, 0, 0, 0 };
+    }
+    else {
+      compileText(t, offsetof(DisplayState, Message), TPL_6font[t], TPL_6font2[t], TPL_6maxwidth[t], 2, 1, TPL_6posx[t] + TPL_6maxwidth[t] / 2, TPL_6posy[t]);
+    }
+    compileText(t, offsetof(DisplayState, Station), TPL_0font[t], TPL_0font2[t], TPL_0maxwidth[t], 1, 1, config.DISPWIDTH / 2 + TPL_0posx[t], TPL_0posy[t]);
+    compileText(t, offsetof(DisplayState, Track), TPL_1font[t], TPL_1font[t], 0, 1, 0, TPL_1posx[t], TPL_1posy[t]);
+    compileText(t, offsetof(DisplayState, Destination), TPL_2font[t], TPL_2font2[t], TPL_2maxwidth[t], 1, 0, TPL_2posx[t], TPL_2posy[t]);
+    compileText(t, offsetof(DisplayState, Departure), TPL_3font[t], TPL_3font[t], 0, 1, 0, TPL_3posx[t], TPL_3posy[t]);
+    compileText(t, offsetof(DisplayState, Train), TPL_4font[t], TPL_4font[t], 0, 1, 0, TPL_4posx[t], TPL_4posy[t]);
+    if (d.count < TPLOPS){
+      d.op[d.count++] = { OP_LOGO, 0, 0, 0, 0, 0, 0, 0, 0 };
     }
   }
-*/
+}
 
-  disp.nextPage();
 
-  // Screenshot
-  if (config.PRINTBUF == 1){
-    printBuffer();
-    config.PRINTBUF = 0;
+// TaskScheduler callback method, write to all connected displays
+// Displays that need drawing are drawn in the order they were drawn last within a time budget.
+// Scrolling messages are drawn with every run, other displays only when their content changed.
+// Displays changed by the same hand-off are drawn in the same run, a message for several displays is never split.
+#define RENDERBUDGET 80            // percent of the display task interval available for drawing and sending
+#define FPSINTERVAL  5000          // ms, interval of the fps statistics
+void send2display(void)
+{
+  TimingScope timed(timing[TM_DISPLAYS]);
+  if (config.MQTT_DEBUG == 1){
+    Serial.print(F(" tSd: overrun = "));
+    Serial.println(tSd.getOverrun());
+    //Serial.print(F(", start delayed by "));
+    //Serial.println(tSd.getStartDelay());
+  }
+  // Hand-off from loop(), the queued messages and the time and date variables are copied into ZZA[] with the state lock,
+  // drawing and sending run without it
+  uint8_t off;
+  DispMask changed;
+  {
+    StateLock lock;
+    timingSchedule(timing[TM_DISPLAYS], tSd.getOverrun(), tSd.getStartDelay());
+    changed = msgDrain();
+    changed |= updVar();
+    off = screenOff;
+  }
+  // Without multiplexer only one display can be connected
+  uint8_t n = 1;
+  if (config.MUX > 0){
+    n = config.NUMDISP;
+  }
+  for (uint8_t i = 0; i < n; i++){
+    panelPower(i, off);
+  }
+  // Collect the displays to draw, sorted by the time they were drawn last
+  uint8_t due[MAXDISP];
+  uint8_t m = 0;
+  for (uint8_t i = 0; i < n; i++){
+    DisplayState &z = ZZA[i];
+    uint8_t t = displayTemplate(i);
+    bool scrolling = (TPL_6scroll[t] == 1 && strlen(z.Message) > 1);
+    if (!scrolling && z.stripLen > 0){
+      tickerRelease(z);
+    }
+    if (!scrolling && z.drawnVersion == z.version && config.PRINTBUF == 0){
+      z.framesSkipped++;
+      continue;
+    }
+    uint8_t k = m++;
+    while (k > 0 && (long)(ZZA[due[k - 1]].lastDraw - z.lastDraw) > 0){
+      due[k] = due[k - 1];
+      k--;
+    }
+    due[k] = i;
+  }
+  // Draw within the budget, displays left over are drawn first in the next run. Changed displays and screenshots
+  // ignore the budget.
+  unsigned long start = micros();
+  unsigned long budget = tSd.getInterval() * RENDERBUDGET * 10;
+  for (uint8_t k = 0; k < m; k++){
+    if (k > 0 && ((changed >> due[k]) & 1) == 0 && micros() - start > budget && config.PRINTBUF == 0){
+      ZZA[due[k]].framesDeferred++;
+      continue;
+    }
+    renderDisplay(due[k]);
+  }
+  // Screenshot of all displays done
+  config.PRINTBUF = 0;
+  // End of the boot when the first received message was drawn
+  if (!bootShown && m > 0 && msgStats.enqueued > 0){
+    StateLock lock;
+    bootShown = true;
+    bootMark("first message", micros());
+  }
+
+  // Frames per second of every display
+  static unsigned long fpsStart = 0;
+  unsigned long ms = millis();
+  if (ms - fpsStart >= FPSINTERVAL){
+    for (uint8_t i = 0; i < MAXDISP; i++){
+      ZZA[i].fpsX10 = (ZZA[i].framesSent - ZZA[i].fpsFrames) * 10000UL / (ms - fpsStart);
+      ZZA[i].fpsFrames = ZZA[i].framesSent;
+    }
+    msgStats.rateX10 = (msgStats.enqueued - msgStats.rateFrom) * 10000UL / (ms - fpsStart);
+    msgStats.rateFrom = msgStats.enqueued;
+    fpsStart = ms;
   }
-  offset1-=1;
-  if ( (u8g2_uint_t)offset1 < (u8g2_uint_t)-width1 )
-    offset1 = 0;
 }
 
 
-// *** Write to Display 2 ***
-void send2display2(void)
+// Template of display i, side B displays use the next template if it is marked as side B
+uint8_t displayTemplate(uint8_t i)
 {
-  // Template number
-  uint8_t t = ZZA2_Template.toInt();
+  uint8_t t = ZZA[i].Template;
   if (t > 9){
     t = 0;
   }
-  if (DPL_side[1] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
+  if (DPL_side[i] == 1){
+    if (t < 9 && TPL_side[t] == 0 && TPL_side[t+1] == 1){
       t = t+1;
     }
   }
+  return t;
+}
 
-  DMUX(1);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
+
+// *** Write to Display i ***
+void renderDisplay(uint8_t i)
+{
+  DisplayState &z = ZZA[i];
+  uint8_t t = displayTemplate(i);
+  bool scrolling = (TPL_6scroll[t] == 1 && strlen(z.Message) > 1);
+  bool unchanged = (z.drawnVersion == z.version);
+  TimingScope timed(timing[TM_RENDER + i]);
+  z.drawnVersion = z.version;
+  z.lastDraw = millis();
+  z.framesSent++;
+  // Interval between scrolling frames, shows the jitter of the ticker
+  if (scrolling){
+    unsigned long us = micros();
+    if (z.lastScrollUs != 0){
+      StateLock lock;
+      timingAdd(timing[TM_SCROLL], us - z.lastScrollUs);
+    }
+    z.lastScrollUs = us;
   }
   else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[1]);
-  //disp.setContrast(DPL_contrast[1]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA2_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA2_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA2_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA2_Message);
-    }
+    z.lastScrollUs = 0;
+  }
+  // Send only the ticker band when nothing but the scroll offset changed, needs a full frame buffer constructor
+  bool partial = (scrolling && unchanged && disp.getBufferTileHeight() * 8 >= config.DISPHEIGHT);
+  uint8_t tx = 0, ty = 0, tw = disp.getBufferTileWidth(), th = disp.getBufferTileHeight();
+  panelSelect(i);
+  disp.firstPage();
+  panelInvert(i, TPL_invert[t]);
+  panelFlip(i, DPL_flip[i]);
+  panelContrast(i, DPL_contrast[i]);
+  unsigned long t0 = micros();
+  drawFrame(z, t);
+  if (partial){
+    disp.setFont(fontno[TPL_6font[t]]);
+    tickerArea(t, tx, ty, tw, th);
+  }
+  unsigned long t1 = micros();
+  if (partial){
+    disp.updateDisplayArea(tx, ty, tw, th);
   }
   else {
-    // *** Scrolling message ***
-    if (ZZA2_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width2 = disp.getUTF8Width(ZZA2_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset2;
-      do {
-        //disp.drawUTF8(x, 8, ZZA2_MessageLoop.c_str());
-        disp.drawUTF8(x, TPL_6posy[t], ZZA2_MessageLoop.c_str());
-        x += width2;
-      } while( x < config.DISPWIDTH);
-    }
+    disp.nextPage();
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
+  z.bytesSent += tw * th * 8;
+  z.drawUs += t1 - t0;
+  z.sendUs += micros() - t1;
 
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA2_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
+  // Screenshot
+  if (config.PRINTBUF == 1){
+    printBuffer(i);
   }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA2_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA2_Station.c_str());
+  z.offset-=1;
+  if ( (u8g2_uint_t)z.offset < (u8g2_uint_t)-z.width )
+    z.offset = 0;
+}
 
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA2_Track);
 
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA2_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
+// Draw the content of display state z with template t into the frame buffer, runs the draw list of the template.
+// Fonts and positions of the texts are measured once per content version.
+void drawFrame(DisplayState &z, uint8_t t)
+{
+  const TplDraw &d = tplDraw[t];
+  bool layout = (z.layoutVersion != z.version || z.layoutTpl != t);
+  z.layoutVersion = z.version;
+  z.layoutTpl = t;
+  for (uint8_t k = 0; k < d.count; k++){
+    const TplOp &op = d.op[k];
+    disp.setFontMode(d.fontmode);
+    disp.setDrawColor(d.drawcolor);
+    switch (op.code){
+      case OP_TEXT: {
+        const char *text = (const char *)&z + op.text;
+        if (layout){
+          // Switch to the narrow font for longer texts
+          uint8_t font = op.font;
+          int x = op.x;
+          if (op.maxwidth > 0 || op.center == 1){
+            disp.setFont(fontno[font]);
+            u8g2_uint_t w = disp.getUTF8Width(text);
+            if (op.maxwidth > 0 && w > op.maxwidth){
+              font = op.font2;
+              disp.setFont(fontno[font]);
+              w = disp.getUTF8Width(text);
+            }
+            if (op.center == 1){
+              x -= w / 2;
+            }
+          }
+          z.layoutFont[k] = font;
+          z.layoutX[k] = x;
+        }
+        if (strlen(text) >= op.minlen){
+          disp.setFont(fontno[z.layoutFont[k]]);
+          drawText(z.layoutX[k], op.y, text);
+        }
+        break;
+      }
+      case OP_TICKER:
+        drawTicker(z, t);
+        break;
+      case OP_LOGO:
+        if (z.logo != LOGO_NONE){
+          drawLogo(t, z.logo);
+        }
+        break;
+    }
   }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA2_Destination.c_str());
-
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA2_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA2_Departure);
+}
 
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA2_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA2_Train);
 
-  // Logo
-  if ( ZZA2_Type != "" ) {
-    switchLogo(t, ZZA2_Type);
+// Draw UTF-8 text with the current font and count its characters
+void drawText(u8g2_uint_t x, u8g2_uint_t y, const char *text)
+{
+  disp.drawUTF8(x, y, text);
+  for (const char *p = text; *p != '\0'; p++){
+    glyphsDrawn += ((*p & 0xC0) != 0x80);
   }
-
-  disp.nextPage();
-
-  offset2-=1;
-  if ( (u8g2_uint_t)offset2 < (u8g2_uint_t)-width2 )
-    offset2 = 0;
 }
 
 
-// *** Write to Display 3 ***
-void send2display3(void)
-{ 
-  // Template number
-  uint8_t t = ZZA3_Template.toInt();
-  if (t > 9){
-    t = 0;
+// Draw the scrolling message of display state z with template t
+void drawTicker(DisplayState &z, uint8_t t)
+{
+  if (strlen(z.Message) <= 1){
+    return;
   }
-  if (DPL_side[2] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
-    }
-  }
-
-  DMUX(2);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
-  }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[2]);
-  //disp.setContrast(DPL_contrast[2]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA3_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA3_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA3_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA3_Message);
-    }
-  }
-  else {
-    // *** Scrolling message ***
-    if (ZZA3_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width3 = disp.getUTF8Width(ZZA3_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset3;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA3_MessageLoop.c_str());
-        x += width3;
-      } while( x < config.DISPWIDTH);
-    }
+  disp.setFont(fontno[TPL_6font[t]]);
+  if (z.stripVersion != z.version || z.stripTpl != t){
+    // New message or template, measure and pre-render the message once
+    z.width = disp.getUTF8Width(z.MessageLoop);
+    tickerBuild(z, t);
   }
   disp.setFontMode(TPL_6fontmode[t]);
   disp.setDrawColor(TPL_6drawcolor[t]);
-
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA3_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
+  if (TPL_6boxh[t] > 0){
+    // draw message box
+    disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
+    // draw black box
+    disp.setFontMode(TPL_6fontmode2[t]);
+    disp.setDrawColor(TPL_6drawcolor2[t]);
+    disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
   }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA3_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA3_Station.c_str());
-
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA3_Track);
-
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA3_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
+  if (z.stripLen > 0){
+    tickerDraw(z, t);
   }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA3_Destination.c_str());
-
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA3_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA3_Departure);
-
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA3_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA3_Train);
-
-  // Logo
-  if ( ZZA3_Type != "" ) {
-    switchLogo(t, ZZA3_Type);
+  else {
+    u8g2_uint_t x = z.offset;
+    do {
+      drawText(x, TPL_6posy[t], z.MessageLoop);
+      x += z.width;
+    //} while( x < disp.getDisplayWidth());
+    } while( x < config.DISPWIDTH);
   }
-  
-  disp.nextPage();
+}
 
-  offset3-=1;
-  if ( (u8g2_uint_t)offset3 < (u8g2_uint_t)-width3 )
-    offset3 = 0;
+
+// Check the frame buffer layout, the ticker cache needs a full frame buffer with vertical bytes (SSD13xx, ST7567)
+void tickerInit()
+{
+  disp.clearBuffer();
+  disp.setDrawColor(1);
+  disp.drawPixel(0, 1);
+  tickerOk = (disp.getBufferTileHeight() * 8 >= config.DISPHEIGHT && disp.getBufferPtr()[0] == 0x02);
+  disp.clearBuffer();
 }
 
 
-// *** Write to Display 4 ***
-void send2display4(void)
-{ 
-  // Template number
-  uint8_t t = ZZA4_Template.toInt();
-  if (t > 9){
-    t = 0;
+// Free the ticker cache of display state z, later strips are moved down to keep the pool contiguous
+void tickerRelease(DisplayState &z)
+{
+  if (z.stripLen == 0){
+    return;
   }
-  if (DPL_side[3] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
+  uint16_t end = z.stripPos + z.stripLen;
+  memmove(tickerPool + z.stripPos, tickerPool + end, tickerUsed - end);
+  for (uint8_t j = 0; j < MAXDISP; j++){
+    if (ZZA[j].stripLen > 0 && ZZA[j].stripPos > z.stripPos){
+      ZZA[j].stripPos -= z.stripLen;
     }
   }
+  tickerUsed -= z.stripLen;
+  z.stripLen = 0;
+}
 
-  DMUX(3);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
+
+// Pre-render the scrolling message of display state z with template t into the ticker cache, the message font must be set.
+// The frame buffer is used for drawing and cleared afterwards.
+void tickerBuild(DisplayState &z, uint8_t t)
+{
+  tickerRelease(z);
+  z.stripVersion = z.version;
+  z.stripTpl = t;
+
+  // Only transparent text can be copied into the frame buffer
+  uint8_t fontmode = TPL_6fontmode[t];
+  if (TPL_6boxh[t] > 0){
+    fontmode = TPL_6fontmode2[t];
   }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[3]);
-  //disp.setContrast(DPL_contrast[3]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA4_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA4_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA4_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA4_Message);
-    }
+  if (!tickerOk || fontmode != 1 || z.width == 0){
+    return;
   }
-  else {
-    // *** Scrolling message ***
-    if (ZZA4_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width4 = disp.getUTF8Width(ZZA4_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset4;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA4_MessageLoop.c_str());
-        x += width4;
-      } while( x < disp.getDisplayWidth());
+  uint16_t bw = disp.getBufferTileWidth() * 8;
+  uint16_t dw = disp.getDisplayWidth();
+  int y0 = constrain(TPL_6posy[t] - disp.getMaxCharHeight(), 0, disp.getBufferTileHeight() * 8);
+  int y1 = constrain(TPL_6posy[t] - disp.getDescent() + 1, y0, disp.getBufferTileHeight() * 8);
+  uint8_t row = y0 / 8;
+  uint8_t rows = (y1 + 7) / 8 - row;
+  uint32_t len = (uint32_t)rows * z.width;
+  if (rows == 0 || len > (uint32_t)(TICKERPOOL - tickerUsed)){
+    if (config.MQTT_DEBUG == 1){
+      Serial.printf("Ticker cache full, message rendered live (%u bytes)\n", (unsigned int)len);
     }
+    return;
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
 
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA4_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
+  // Draw the message in slices of the display width and copy the tile rows into the pool
+  uint8_t *buf = disp.getBufferPtr();
+  uint8_t *strip = tickerPool + tickerUsed;
+  disp.setFontMode(1);
+  disp.setDrawColor(1);
+  for (uint16_t x0 = 0; x0 < z.width; x0 += dw){
+    memset(buf + row * bw, 0, rows * bw);
+    drawText((u8g2_uint_t)(0 - x0), TPL_6posy[t], z.MessageLoop);
+    uint16_t n = min((uint16_t)(z.width - x0), dw);
+    for (uint8_t r = 0; r < rows; r++){
+      memcpy(strip + r * z.width + x0, buf + (row + r) * bw, n);
+    }
   }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA4_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA4_Station.c_str());
+  disp.clearBuffer();
+
+  z.stripPos = tickerUsed;
+  z.stripLen = len;
+  z.stripRow = row;
+  z.stripRows = rows;
+  tickerUsed += len;
+}
 
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA4_Track);
 
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA4_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
+// Copy the pre-rendered message of display state z at the current scroll offset into the frame buffer
+void tickerDraw(DisplayState &z, uint8_t t)
+{
+  uint8_t color = TPL_6drawcolor[t];
+  if (TPL_6boxh[t] > 0){
+    color = TPL_6drawcolor2[t];
+  }
+  uint8_t *buf = disp.getBufferPtr();
+  uint16_t bw = disp.getBufferTileWidth() * 8;
+  uint16_t dw = disp.getDisplayWidth();
+  uint16_t start = (uint16_t)(0 - z.offset) % z.width;
+  for (uint8_t r = 0; r < z.stripRows; r++){
+    uint8_t *dst = buf + (z.stripRow + r) * bw;
+    const uint8_t *src = tickerPool + z.stripPos + r * z.width;
+    uint16_t c = start;
+    for (uint16_t x = 0; x < dw; x++){
+      if (color == 0){
+        dst[x] &= ~src[c];
+      }
+      else if (color == 1){
+        dst[x] |= src[c];
+      }
+      else {
+        dst[x] ^= src[c];
+      }
+      if (++c >= z.width){
+        c = 0;
+      }
+    }
   }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA4_Destination.c_str());
+}
 
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA4_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA4_Departure);
 
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA4_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA4_Train);
+// Tile area (8x8 pixel blocks) of the scrolling message of template t, the message font must be set
+void tickerArea(uint8_t t, uint8_t &tx, uint8_t &ty, uint8_t &tw, uint8_t &th)
+{
+  // Rows covered by the font around the baseline, all columns
+  int x0 = 0;
+  int x1 = config.DISPWIDTH;
+  int y0 = TPL_6posy[t] - disp.getMaxCharHeight();
+  int y1 = TPL_6posy[t] - disp.getDescent() + 1;
+  // Text drawn transparent in black is only visible inside the message box
+  if (TPL_6boxh[t] > 0 && TPL_6drawcolor2[t] == 0 && TPL_6fontmode2[t] == 1){
+    x0 = max(x0, TPL_6boxx[t]);
+    x1 = min(x1, TPL_6boxx[t] + TPL_6boxw[t]);
+    y0 = max(y0, TPL_6boxy[t]);
+    y1 = min(y1, TPL_6boxy[t] + TPL_6boxh[t]);
+  }
+  x0 = constrain(x0, 0, disp.getBufferTileWidth() * 8);
+  x1 = constrain(x1, x0, disp.getBufferTileWidth() * 8);
+  y0 = constrain(y0, 0, disp.getBufferTileHeight() * 8);
+  y1 = constrain(y1, y0, disp.getBufferTileHeight() * 8);
+  tx = x0 / 8;
+  ty = y0 / 8;
+  tw = (x1 + 7) / 8 - tx;
+  th = (y1 + 7) / 8 - ty;
+}
 
-  // Logo
-  if ( ZZA4_Type != "" ) {
-    switchLogo(t, ZZA4_Type);
-  }
-  
-  disp.nextPage();
 
-  offset4-=1;
-  if ( (u8g2_uint_t)offset4 < (u8g2_uint_t)-width4 )
-    offset4 = 0;
+// Display logo handle n of the TrainType field, read in place from flash or from the logo files in RAM
+void drawLogo(uint8_t t, uint16_t n)
+{
+  const Logo &l = logoGet(n);
+  disp.drawXBMP( TPL_5logox[t], TPL_5logoy[t], l.w, l.h, l.bits);
 }
 
 
-// *** Write to Display 5 ***
-void send2display5(void)
-{ 
-  // Template number
-  uint8_t t = ZZA5_Template.toInt();
-  if (t > 9){
-    t = 0;
-  }
-  if (DPL_side[4] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
+// Resolve the TrainType of all displays to a logo handle again after the logo table was rebuilt
+void resolveLogos()
+{
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    uint16_t n = logoFind(ZZA[i].Type);
+    if (n != ZZA[i].logo){
+      ZZA[i].logo = n;
+      ZZA[i].version++;
     }
   }
+}
 
-  DMUX(4);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
+
+// Enable ScreenSaver for all displays, send2display() switches the displays, displays already in this mode are skipped
+void screenSaver(int s)
+{
+  StateLock lock;
+  screenOff = s;
+}
+
+
+// Share RMD configuration via MQTT with other devices in the network
+void sendConfiguration()
+{
+  String ConfigRMD = "";
+  JsonDocument doc;
+  doc["RMDCFG"] = config.WIFI_DEVICENAME;
+  doc["V"] = config.VER;
+  char key[8];
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    snprintf(key, sizeof(key), "I%u", i);
+    doc[key] = DPL_id[i];
+    snprintf(key, sizeof(key), "T%u", i);
+    doc[key] = DPL_track[i];
+    snprintf(key, sizeof(key), "S%u", i);
+    doc[key] = DPL_station[i];
+  }
+  doc["HEAP"] = ESP.getFreeHeap();
+  doc["FRAG"] = heapFragmentation();
+  // Serialize JSON to variable
+  if (serializeJson(doc, ConfigRMD) == 0) {
+    Serial.println(F("Failed to write config json to variable"));
   }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[4]);
-  //disp.setContrast(DPL_contrast[4]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA5_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA5_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA5_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA5_Message);
-    }
+  Serial.print(F("Configuration published for: "));
+  Serial.println(config.WIFI_DEVICENAME);
+  Serial.printf("Free heap: %u bytes, heap fragmentation: %u %%\n", (unsigned int)ESP.getFreeHeap(), heapFragmentation());
+  Serial.printf("Message queue: %u payloads, %u enqueued, %u coalesced, %u dropped, high water %u of %u, %u.%u messages/s\n", msgStats.payloads, msgStats.enqueued, msgStats.coalesced, msgStats.dropped, msgStats.highWater, MSGQUEUE, msgStats.rateX10 / 10, msgStats.rateX10 % 10);
+  if (config.MQTT_ROUTE == 3){
+    Serial.printf("Router: %u messages forwarded to display topics\n", msgStats.forwarded);
   }
-  else {
-    // *** Scrolling message ***
-    if (ZZA5_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width5 = disp.getUTF8Width(ZZA5_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset5;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA5_MessageLoop.c_str());
-        x += width5;
-      } while( x < config.DISPWIDTH);
-    }
+  for (uint8_t i = 0; i < config.NUMDISP; i++){
+    uint32_t n = max(ZZA[i].framesSent, (uint32_t)1);
+    Serial.printf("Display %u: %u.%u fps, frames sent %u, skipped %u, deferred %u, %u bytes/frame, draw %u us/frame, send %u us/frame, I2C %u transfers, %u bytes\n", i + 1, ZZA[i].fpsX10 / 10, ZZA[i].fpsX10 % 10, ZZA[i].framesSent, ZZA[i].framesSkipped, ZZA[i].framesDeferred, ZZA[i].bytesSent / n, ZZA[i].drawUs / n, ZZA[i].sendUs / n, panel[i].i2cTransactions, panel[i].i2cBytes);
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
-
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA5_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
+  if (config.MQTT_DEBUG == 1){
+    Serial.println(ConfigRMD);
   }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA5_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA5_Station.c_str());
-
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA5_Track);
+  client.publish("rmnet/config", ConfigRMD, false);
+  client.publish("rmnet/stats", metricsJson(true), false);
+}
 
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA5_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
-  }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA5_Destination.c_str());
 
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA5_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA5_Departure);
+// Update assetUse[]
+void updateAssets()
+{
+  uint32_t settings = 0;
+  for (uint8_t k = 0; k < SNAPREGIONS; k++){
+    settings += snapRegions[k].size;
+  }
+  assetUse[AS_LOGOS]     = { "logos", logoFlash, logoRam + logoCap * (uint32_t)sizeof(Logo) };
+  assetUse[AS_FONTNAMES] = { "font names", sizeof(fonts), 0 };
+  assetUse[AS_SETTINGS]  = { "configuration and templates", 0, settings };
+  assetUse[AS_DRAWLISTS] = { "compiled templates", 0, sizeof(tplDraw) };
+  assetUse[AS_DISPLAYS]  = { "display state", 0, sizeof(ZZA) + sizeof(panel) };
+  assetUse[AS_QUEUE]     = { "message queue", 0, sizeof(msgQueue) };
+  assetUse[AS_TICKER]    = { "ticker cache", 0, sizeof(tickerPool) };
+  assetUse[AS_TIMING]    = { "timing statistics", 0, sizeof(timing) };
+}
 
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA5_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA5_Train);
 
-  // Logo
-  if ( ZZA5_Type != "" ) {
-    switchLogo(t, ZZA5_Type);
+// Print the flash and RAM usage of the static assets and buffers to serial out
+void printAssets()
+{
+  updateAssets();
+  Serial.printf("\n  %-28s %11s %11s\n", "Assets", "flash bytes", "RAM bytes");
+  for (uint8_t k = 0; k < AS_COUNT; k++){
+    Serial.printf("  %-28s %11lu %11lu\n", assetUse[k].name, (unsigned long)assetUse[k].flash, (unsigned long)assetUse[k].ram);
   }
-  
-  disp.nextPage();
-
-  offset5-=1;
-  if ( (u8g2_uint_t)offset5 < (u8g2_uint_t)-width5 )
-    offset5 = 0;
+  Serial.printf("  Free heap %lu bytes\n", (unsigned long)ESP.getFreeHeap());
 }
 
 
-// *** Write to Display 6 ***
-void send2display6(void)
-{ 
-  // Template number
-  uint8_t t = ZZA6_Template.toInt();
-  if (t > 9){
-    t = 0;
-  }
-  if (DPL_side[5] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
-    }
+// Timing statistics as JSON, compact = [avg, p99, max, overruns] in microseconds for all tasks that have run
+String metricsJson(bool compact)
+{
+  String out = "";
+  JsonDocument doc;
+  char name[16];
+  if (compact){
+    doc["ID"] = config.WIFI_DEVICENAME;
+    doc["HEAP"] = ESP.getFreeHeap();
   }
-
-  DMUX(5);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
+  else {
+    doc["device"] = config.WIFI_DEVICENAME;
+    doc["uptime_s"] = millis() / 1000;
+    doc["heap"] = ESP.getFreeHeap();
+    doc["heap_frag"] = heapFragmentation();
+  }
+  if (compact){
+    JsonArray q = doc["Q"].to<JsonArray>();
+    q.add(msgStats.payloads);
+    q.add(msgStats.enqueued);
+    q.add(msgStats.coalesced);
+    q.add(msgStats.dropped);
+    q.add(msgStats.highWater);
+    q.add(msgStats.rateX10 / 10.0);
   }
   else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[5]);
-  //disp.setContrast(DPL_contrast[5]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA6_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA6_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA6_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA6_Message);
+    JsonObject q = doc["queue"].to<JsonObject>();
+    q["payloads"] = msgStats.payloads;
+    q["enqueued"] = msgStats.enqueued;
+    q["coalesced"] = msgStats.coalesced;
+    q["dropped"] = msgStats.dropped;
+    q["high_water"] = msgStats.highWater;
+    q["forwarded"] = msgStats.forwarded;
+    q["size"] = MSGQUEUE;
+    q["messages_per_s"] = msgStats.rateX10 / 10.0;
+    updateAssets();
+    for (uint8_t k = 0; k < AS_COUNT; k++){
+      JsonObject a = doc["assets"][assetUse[k].name].to<JsonObject>();
+      a["flash"] = assetUse[k].flash;
+      a["ram"] = assetUse[k].ram;
+    }
+    JsonObject l = doc["logos"].to<JsonObject>();
+    l["count"] = logoCount;
+    l["ram"] = logoRam;
+    l["ram_budget"] = config.LOGORAM;
+    JsonObject b = doc["boot_ms"].to<JsonObject>();
+    for (uint8_t k = 0; k < bootPhaseCount; k++){
+      b[bootPhase[k].name] = bootPhase[k].us / 1000;
     }
   }
-  else {
-    // *** Scrolling message ***
-    if (ZZA6_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width6 = disp.getUTF8Width(ZZA6_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset6;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA6_MessageLoop.c_str());
-        x += width6;
-      } while( x < config.DISPWIDTH);
+  for (uint8_t k = 0; k < TM_COUNT; k++){
+    // The render task writes its statistics on the other core, copy them in one piece
+    TaskTiming m;
+    {
+      StateLock lock;
+      m = timing[k];
+    }
+    if (m.count == 0){
+      continue;
+    }
+    if (k < TM_RENDER){
+      strlcpy(name, timingName[k], sizeof(name));
+    }
+    else {
+      snprintf(name, sizeof(name), "render%u", k - TM_RENDER + 1);
+    }
+    if (compact){
+      JsonArray a = doc["T"][name].to<JsonArray>();
+      a.add(timingAvg(m));
+      a.add(timingP99(m));
+      a.add(m.maxUs);
+      a.add(m.overruns);
+    }
+    else {
+      JsonObject o = doc["tasks"][name].to<JsonObject>();
+      o["count"] = m.count;
+      o["min_us"] = m.minUs;
+      o["avg_us"] = timingAvg(m);
+      o["p99_us"] = timingP99(m);
+      o["max_us"] = m.maxUs;
+      o["overruns"] = m.overruns;
+      o["max_start_delay_ms"] = m.maxDelayMs;
     }
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
-
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA6_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
+  for (uint8_t i = 0; i < config.NUMDISP; i++){
+    if (compact){
+      doc["FPS"].add(ZZA[i].fpsX10 / 10.0);
+    }
+    else {
+      JsonObject o = doc["displays"].add<JsonObject>();
+      o["fps"] = ZZA[i].fpsX10 / 10.0;
+      o["frames_deferred"] = ZZA[i].framesDeferred;
+      o["i2c_transfers"] = panel[i].i2cTransactions;
+      o["i2c_bytes"] = panel[i].i2cBytes;
+    }
   }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA6_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA6_Station.c_str());
+  if (serializeJson(doc, out) == 0) {
+    Serial.println(F("Failed to write metrics json to variable"));
+  }
+  return out;
+}
 
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA6_Track);
 
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA6_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
+// Boot timeline as JSON, end of every phase in milliseconds after reset
+String bootJson()
+{
+  String out = "";
+  JsonDocument doc;
+  doc["ID"] = config.WIFI_DEVICENAME;
+  doc["FASTBOOT"] = config.FASTBOOT;
+  for (uint8_t k = 0; k < bootPhaseCount; k++){
+    doc["boot_ms"][bootPhase[k].name] = bootPhase[k].us / 1000;
+  }
+  if (serializeJson(doc, out) == 0) {
+    Serial.println(F("Failed to write boot json to variable"));
   }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA6_Destination.c_str());
+  return out;
+}
 
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA6_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA6_Departure);
 
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA6_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA6_Train);
+// Write display buffer/screenshot of display i to serial out
+void printBuffer(uint8_t i)
+{
+  Serial.print(F("\nScreenshot of display "));
+  Serial.print(i + 1);
+  Serial.println(F(" as XBM image\n"));
+  disp.writeBufferXBM(Serial);     // Write XBM image to serial out
+  Serial.println();
+}
 
-  // Logo
-  if ( ZZA6_Type != "" ) {
-    switchLogo(t, ZZA6_Type);
-  }
-  
-  disp.nextPage();
 
-  offset6-=1;
-  if ( (u8g2_uint_t)offset6 < (u8g2_uint_t)-width6 )
-    offset6 = 0;
+// CRC-32 of the frame buffer, identifies a rendered image
+uint32_t frameCrc()
+{
+  return crc32(0, disp.getBufferPtr(), disp.getBufferTileWidth() * disp.getBufferTileHeight() * 8);
 }
 
 
-// *** Write to Display 7 ***
-void send2display7(void)
-{ 
-  // Template number
-  uint8_t t = ZZA7_Template.toInt();
-  if (t > 9){
-    t = 0;
-  }
-  if (DPL_side[6] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
-    }
-  }
-
-  DMUX(6);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
-  }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[6]);
-  //disp.setContrast(DPL_contrast[6]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA7_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA7_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
+// Render benchmark, draws every template with sample content into the frame buffer without sending it.
+// Returns one CSV line per template and case, draw_us_max and glyphs include pre-rendering the ticker.
+// crc32 identifies the first frame, compare it between firmware versions. With /bench?xbm=1 the first frame
+// of every case is written to Serial as XBM image, /bench?live=1 draws scrolling messages without the ticker cache.
+#define BENCHFRAMES 32             // frames drawn for scrolling messages
+void handleBench()
+{
+  DrawLock draw;
+  static const char *cases[5][4] = {   // name, station, destination, message
+    { "short",   "Bhf01", "Bonn", "" },
+    { "long",    "Hamburg-Altona Nord", "Frankfurt (Main) Flughafen Fernbahnhof", "" },
+    { "utf8",    "Köln-Mülheim Süd", "Düsseldorf Flughafen Terminal", "" },
+    { "msg",     "Bhf01", "Bonn", "5min Verspätung - 5min delayed" },
+    { "longmsg", "Bhf01", "Bonn", "Wegen einer Störung im Betriebsablauf verkehren die Züge heute mit bis zu 30 Minuten Verspätung +++ Delays of up to 30 minutes" }
+  };
+  bool xbm = webserver.hasArg("xbm");
+  bool cache = tickerOk;
+  if (webserver.hasArg("live")){
+    tickerOk = false;
+  }
+  uint16_t full = disp.getBufferTileWidth() * disp.getBufferTileHeight() * 8;
+  DisplayState *b = new DisplayState();
+  char line[100];
+  String out = "template,case,width,height,scroll,frames,glyphs,draw_us_avg,draw_us_max,bytes_full,bytes_partial,crc32\n";
+  for (uint8_t t = 0; t < 10; t++){
+    for (uint8_t c = 0; c < 5; c++){
+      memset(b, 0, sizeof(DisplayState));
+      strlcpy(b->Station, cases[c][1], sizeof(b->Station));
+      strlcpy(b->Track, "1", sizeof(b->Track));
+      strlcpy(b->Destination, cases[c][2], sizeof(b->Destination));
+      strlcpy(b->Departure, "10:22", sizeof(b->Departure));
+      strlcpy(b->Train, "ICE 597", sizeof(b->Train));
+      strlcpy(b->Type, "ICE", sizeof(b->Type));
+      b->logo = logoFind(b->Type);
+      strlcpy(b->Message, cases[c][3], sizeof(b->Message));
+      snprintf(b->MessageLoop, sizeof(b->MessageLoop), " +++ %s", b->Message);
+      b->version = 1;
+      b->stripTpl = 0xFF;          // measure and pre-render the ticker in the first frame
+      bool scroll = (TPL_6scroll[t] == 1 && strlen(b->Message) > 1);
+      uint8_t frames = scroll ? BENCHFRAMES : 1;
+      uint32_t sum = 0, maxUs = 0, crc = 0;
+      glyphsDrawn = 0;
+      for (uint8_t f = 0; f < frames; f++){
+        disp.clearBuffer();
+        unsigned long t0 = micros();
+        drawFrame(*b, t);
+        uint32_t us = micros() - t0;
+        sum += us;
+        maxUs = max(maxUs, us);
+        if (f == 0){
+          crc = frameCrc();
+          if (xbm){
+            Serial.printf("\nTemplate T%u, case %s as XBM image\n\n", t, cases[c][0]);
+            disp.writeBufferXBM(Serial);
+            Serial.println();
+          }
+        }
+        b->offset -= 1;
+        if ( (u8g2_uint_t)b->offset < (u8g2_uint_t)-b->width )
+          b->offset = 0;
       }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA7_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA7_Message);
-    }
-  }
-  else {
-    // *** Scrolling message ***
-    if (ZZA7_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width7 = disp.getUTF8Width(ZZA7_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
+      uint8_t tx = 0, ty = 0, tw = 0, th = 0;
+      if (scroll){
+        disp.setFont(fontno[TPL_6font[t]]);
+        tickerArea(t, tx, ty, tw, th);
       }
-      x = offset7;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA7_MessageLoop.c_str());
-        x += width7;
-      } while( x < config.DISPWIDTH);
+      tickerRelease(*b);
+      snprintf(line, sizeof(line), "T%u,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%08x\n", t, cases[c][0], config.DISPWIDTH, config.DISPHEIGHT,
+               scroll, frames, glyphsDrawn, sum / frames, maxUs, full, tw * th * 8, crc);
+      out += line;
+      yield();
     }
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
+  delete b;
+  tickerOk = cache;
+  redrawAll();
+  webserver.send(200, "text/csv", out);
+}
 
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA7_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
-  }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA7_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA7_Station.c_str());
 
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA7_Track);
+// NTP time updater, called every 100ms
+void updateTime()
+{
+  time(&now);                         // read the current time
+  localtime_r(&now, &tm);             // update the structure tm with the current time
 
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA7_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
+  static int lastMin = -1;
+  static int lastMday = -1;
+  if (millis() - lastNTP < 20000){
+    // Format time and date only when they change, send2display() updates the displays using them
+    if (tm.tm_min != lastMin || tm.tm_mday != lastMday){
+      StateLock lock;
+      strftime(ntptime, sizeof(ntptime), "%H:%M", &tm);
+      strftime(ntpdate, sizeof(ntpdate), "%d.%m.%Y", &tm);
+      ntpToRailroad();
+      lastMin = tm.tm_min;
+      lastMday = tm.tm_mday;
+    }
+    lastNTP = millis();
   }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA7_Destination.c_str());
-
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA7_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA7_Departure);
-
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA7_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA7_Train);
-
-  // Logo
-  if ( ZZA7_Type != "" ) {
-    switchLogo(t, ZZA7_Type);
+  else if (lastMin != -1){
+    StateLock lock;
+    strcpy(ntptime, "no NTP time");
+    ntpToRailroad();
+    lastMin = -1;
   }
+  //Serial.print(ntptime);
+  //if (tm.tm_isdst == 1)                  // Daylight Saving Time flag
+  //  Serial.println("\t  Daylight Saving Time");
+  //else
+  //  Serial.println("\t  Standard Time");
+}
 
-  disp.nextPage();
 
-  offset7-=1;
-  if ( (u8g2_uint_t)offset7 < (u8g2_uint_t)-width7 )
-    offset7 = 0;
+// Without MQTT_TOPIC1 the railroad time and date are the NTP time and date, call with the state lock
+void ntpToRailroad()
+{
+  if (strlen(config.MQTT_TOPIC1) == 0){
+    strcpy(rrtime, ntptime);
+    strcpy(rrdate, ntpdate);
+  }
 }
 
 
-// *** Write to Display 8 ***
-void send2display8(void)
-{ 
-  // Template number
-  uint8_t t = ZZA8_Template.toInt();
-  if (t > 9){
-    t = 0;
-  }
-  if (DPL_side[7] == 1){
-    if (TPL_side[t] == 0 && TPL_side[t+1] == 1){
-      t = t+1;
+// Rebuild the display ID lookup after DPL_id has been loaded or changed
+void buildDisplayIds()
+{
+  dplIdCount = 0;
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    if (DPL_id[i][0] == '\0'){
+      continue;
     }
-  }
-
-  DMUX(7);
-  u8g2_uint_t x;
-  disp.firstPage();
-  if (TPL_invert[t] == 1){
-    disp.sendF("c", 0x0a7);
-  }
-  else {
-    disp.sendF("c", 0x0a6);
-  }
-  disp.setFlipMode(DPL_flip[7]);
-  //disp.setContrast(DPL_contrast[7]);
-  // Message
-  // *** Message only ***
-  if (TPL_6scroll[t] != 1){
-    if (ZZA8_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      // Switch to narrow font for longer messages
-      if (disp.getUTF8Width(ZZA8_Message.c_str()) > TPL_6maxwidth[t]){
-        disp.setFont(fontno[TPL_6font2[t]]);
-      }
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      
-      disp.setCursor(TPL_6posx[t] + (TPL_6maxwidth[t] / 2) - (disp.getUTF8Width(ZZA8_Message.c_str()) / 2), TPL_6posy[t]);
-      disp.print(ZZA8_Message);
+    uint8_t k = 0;
+    while (k < dplIdCount && strcmp(dplIds[k].id, DPL_id[i]) != 0){
+      k++;
     }
-  }
-  else {
-    // *** Scrolling message ***
-    if (ZZA8_Message.length() > 1){
-      disp.setFont(fontno[TPL_6font[t]]);
-      width8 = disp.getUTF8Width(ZZA8_MessageLoop.c_str());
-      disp.setFontMode(TPL_6fontmode[t]);
-      disp.setDrawColor(TPL_6drawcolor[t]);
-      if (TPL_6boxh[t] > 0){
-        disp.drawBox(TPL_6boxx[t], TPL_6boxy[t], TPL_6boxw[t], TPL_6boxh[t]);
-        disp.setFontMode(TPL_6fontmode2[t]);
-        disp.setDrawColor(TPL_6drawcolor2[t]);
-        disp.drawBox(TPL_6box2x[t], TPL_6box2y[t], TPL_6box2w[t], TPL_6box2h[t]);
-      }
-      x = offset8;
-      do {
-        disp.drawUTF8(x, TPL_6posy[t], ZZA8_MessageLoop.c_str());
-        x += width8;
-      } while( x < config.DISPWIDTH);
+    if (k == dplIdCount){
+      strlcpy(dplIds[k].id, DPL_id[i], sizeof(dplIds[k].id));
+      dplIds[k].len = strlen(dplIds[k].id);
+      dplIds[k].mask = 0;
+      dplIdCount++;
     }
+    dplIds[k].mask |= (DispMask)1 << i;
   }
-  disp.setFontMode(TPL_6fontmode[t]);
-  disp.setDrawColor(TPL_6drawcolor[t]);
-
-  // Station
-  disp.setFont(fontno[TPL_0font[t]]);
-  // Switch to narrow font for longer station names
-  if (disp.getUTF8Width(ZZA8_Station.c_str()) > TPL_0maxwidth[t]){
-    disp.setFont(fontno[TPL_0font2[t]]);
-  }
-  disp.drawUTF8((config.DISPWIDTH / 2) - (disp.getUTF8Width(ZZA8_Station.c_str()) / 2) + TPL_0posx[t], TPL_0posy[t], ZZA8_Station.c_str());
-
-  // Track
-  disp.setFont(fontno[TPL_1font[t]]);
-  disp.setCursor(TPL_1posx[t],TPL_1posy[t]);
-  disp.print(ZZA8_Track);
-
-  // Destination
-  disp.setFont(fontno[TPL_2font[t]]);
-  // Switch to narrow font for longer destination names
-  if (disp.getUTF8Width(ZZA8_Destination.c_str()) > TPL_2maxwidth[t]){
-    disp.setFont(fontno[TPL_2font2[t]]);
-  }
-  disp.drawUTF8(TPL_2posx[t], TPL_2posy[t], ZZA8_Destination.c_str());
+}
 
-  // Departure
-  disp.setFont(fontno[TPL_3font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA8_Departure.c_str()), TPL_3posy[t]);
-  disp.setCursor(TPL_3posx[t], TPL_3posy[t]);
-  disp.print(ZZA8_Departure);
 
-  // Train
-  disp.setFont(fontno[TPL_4font[t]]);
-  //disp.setCursor(disp.getDisplayWidth() - disp.getUTF8Width(ZZA8_Train.c_str()), TPL_4posy[t]);
-  disp.setCursor(TPL_4posx[t], TPL_4posy[t]);
-  disp.print(ZZA8_Train);
+// Compile the received message and departure of display i, call after MessageO or DepartureO changed
+void compileDisplayVars(uint8_t i)
+{
+  DisplayState &z = ZZA[i];
+  z.vars = 0;
+  z.msgSegCount = compileVars(z.MessageO, z.msgSegs, ZZA_MSGSEGS, VAR_ALL, z.vars);
+  z.depSegCount = compileVars(z.DepartureO, z.depSegs, ZZA_DEPSEGS, VAR_RRTIME, z.vars);
+}
 
-  // Logo
-  if ( ZZA8_Type != "" ) {
-    switchLogo(t, ZZA8_Type);
-  }
-  disp.nextPage();
 
-  offset8-=1;
-  if ( (u8g2_uint_t)offset8 < (u8g2_uint_t)-width8 )
-    offset8 = 0;
+// Update the displayed message, departure and ticker of display i from the received fields
+void updDisplayVar(uint8_t i)
+{
+  DisplayState &z = ZZA[i];
+  char msg[ZZA_MSGLEN];
+  char dep[ZZA_SHORTLEN];
+  expandVars(msg, sizeof(msg), z.MessageO, z.msgSegs, z.msgSegCount, varValues);
+  expandVars(dep, sizeof(dep), z.DepartureO, z.depSegs, z.depSegCount, varValues);
+  if (strcmp(msg, z.Message) == 0 && strcmp(dep, z.Departure) == 0){
+    return;  // e.g. time not changed
+  }
+  strcpy(z.Message, msg);
+  strcpy(z.MessageLoop, " +++ ");
+  strcat(z.MessageLoop, z.Message);
+  strcpy(z.Departure, dep);
+  z.version++;  // the ticker width is measured with the template font when the display is drawn
 }
 
 
-// Display a logo based on TrainType field
-void switchLogo(uint8_t t, String ZZA_Type)
+// Update time and date variables in displayed messages, only displays using a changed variable are updated.
+// Called by send2display() with the state lock, the variables are written in loop(). Returns the updated displays.
+DispMask updVar()
 {
-  if (ZZA_Type == logoId[0]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[0], logoh[0], logo0);
-  }
-  else if (ZZA_Type == logoId[1]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[1], logoh[1], logo1);
-  }
-  else if (ZZA_Type == logoId[2]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[2], logoh[2], logo2);
-  }
-  else if (ZZA_Type == logoId[3]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[3], logoh[3], logo3);
-  }
-  else if (ZZA_Type == logoId[4]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[4], logoh[4], logo4);
-  }
-  else if (ZZA_Type == logoId[5]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[5], logoh[5], logo5);
-  }
-  else if (ZZA_Type == logoId[6]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[6], logoh[6], logo6);
-  }
-  else if (ZZA_Type == logoId[7]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[7], logoh[7], logo7);
-  }
-  else if (ZZA_Type == logoId[8]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[8], logoh[8], logo8);
-  }
-  else if (ZZA_Type == logoId[9]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[9], logoh[9], logo9);
-  }
-  else if (ZZA_Type == logoId[10]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[10], logoh[10], logo10);
-  }
-  else if (ZZA_Type == logoId[11]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[11], logoh[11], logo11);
-  }
-  else if (ZZA_Type == logoId[12]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[12], logoh[12], logo12);
-  }
-  else if (ZZA_Type == logoId[13]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[13], logoh[13], logo13);
-  }
-  else if (ZZA_Type == logoId[14]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[14], logoh[14], logo14);
-  }
-  else if (ZZA_Type == logoId[15]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[15], logoh[15], logo15);
-  }
-  else if (ZZA_Type == logoId[16]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[16], logoh[16], logo16);
-  }
-  else if (ZZA_Type == logoId[17]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[17], logoh[17], logo17);
+  unsigned long t0 = micros();
+  uint8_t changed = 0;
+  for (uint8_t k = 0; k < 4; k++){
+    const char *v = varValues[k];
+    if (strcmp(v, varLast[k]) != 0){
+      strlcpy(varLast[k], v, sizeof(varLast[k]));
+      changed |= 1 << k;
+    }
   }
-  else if (ZZA_Type == logoId[18]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[18], logoh[18], logo18);
+  if (changed == 0){
+    return 0;
   }
-  else if (ZZA_Type == logoId[19]){
-    disp.drawXBM( TPL_5logox[t], TPL_5logoy[t], logow[19], logoh[19], logo19);
+  DispMask updated = 0;
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    if (ZZA[i].vars & changed){
+      updDisplayVar(i);
+      updated |= (DispMask)1 << i;
+      n++;
+    }
   }
-
-  /*switch (i){ 
-    case 1: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo1);
-            break;
-    case 2: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo2);
-            break;
-    case 3: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo3);
-            break;
-    case 4: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo4);
-            break;
-    case 5: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo5);
-            break;
-    case 6: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo6);
-            break;
-    case 7: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo7);
-            break;
-    case 8: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo8);
-            break;
-    case 9: disp.drawXBM( TPL_6logox[t], TPL_6logoy[t], TPL_6logow[t], TPL_6logoh[t], logo9);
+  timingAdd(timing[TM_UPDVAR], micros() - t0);
+  if (config.MQTT_DEBUG == 1){
+    Serial.printf("updVar: %lu us, %u displays updated\n", micros() - t0, n);
   }
-  //return logo;
-  */
+  return updated;
 }
 
 
-// Enable ScreenSaver for all displays
-void screenSaver(int s)
+// Displays addressed by a received message, by the IDs of the Targets field and the display mask of ZZAMSG v2
+DispMask msgTargets(const ZZAMsg &msg)
 {
-  for (uint8_t i = 0; i < config.NUMDISP; i++)
-  {
-    if (config.MUX == 112){
-      DMUX(i);
-    }
-    else {
-      disp.sendBuffer();
-    }    
-    //DMUX(i);
-    disp.setPowerSave(s);
-    // AEh : Display OFF
-    // AFh : Display ON
-    //disp.sendF("c", 0x0ae);
-    //disp.sendF("c", 0x0af);
-  }
+  DispMask targets = targetMask(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, dplIds, dplIdCount);
+  return targets | (msg.mask & (DispMask)(((uint64_t)1 << MAXDISP) - 1));
 }
 
 
-// Share RMD configuration via MQTT with other devices in the network
-void sendConfiguration()
+// Move a queued message to another slot of the queue
+void msgMove(QueuedMsg &dst, const QueuedMsg &src)
 {
-  String ConfigRMD = "";
-  JsonDocument doc;
-  doc["RMDCFG"] = config.WIFI_DEVICENAME;
-  doc["V"] = config.VER;
-  doc["I0"] = DPL_id[0];
-  doc["I1"] = DPL_id[1];
-  doc["I2"] = DPL_id[2];
-  doc["I3"] = DPL_id[3];
-  doc["I4"] = DPL_id[4];
-  doc["I5"] = DPL_id[5];
-  doc["I6"] = DPL_id[6];
-  doc["I7"] = DPL_id[7];
-  doc["T0"] = DPL_track[0];
-  doc["T1"] = DPL_track[1];
-  doc["T2"] = DPL_track[2];
-  doc["T3"] = DPL_track[3];
-  doc["T4"] = DPL_track[4];
-  doc["T5"] = DPL_track[5];
-  doc["T6"] = DPL_track[6];
-  doc["T7"] = DPL_track[7];
-  doc["S0"] = DPL_station[0];
-  doc["S1"] = DPL_station[1];
-  doc["S2"] = DPL_station[2];
-  doc["S3"] = DPL_station[3];
-  doc["S4"] = DPL_station[4];
-  doc["S5"] = DPL_station[5];
-  doc["S6"] = DPL_station[6];
-  doc["S7"] = DPL_station[7];
-  // Serialize JSON to variable
-  if (serializeJson(doc, ConfigRMD) == 0) {
-    Serial.println(F("Failed to write config json to variable"));
-  }
-  Serial.print(F("Configuration published for: "));
-  Serial.println(config.WIFI_DEVICENAME);
-  if (config.MQTT_DEBUG == 1){
-    Serial.println(ConfigRMD);
+  dst = src;
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    dst.msg.field[f].ptr = dst.buf + (src.msg.field[f].ptr - src.buf);
   }
-  client.publish("rmnet/config", ConfigRMD, false);
 }
 
 
-// Write display buffer/screenshot to serial out
-void printBuffer()
+// Queue a received message for the displays in targets, queued messages for these displays are replaced
+void msgEnqueue(const ZZAMsg &msg, DispMask targets)
 {
-  Serial.println("\nScreenshot of display 1 as XBM image\n");
-  disp.writeBufferXBM(Serial);     // Write XBM image to serial out
-  Serial.println();
+  if (targets == 0){
+    return;
+  }
+  for (uint8_t k = 0; k < msgCount; k++){
+    QueuedMsg &q = msgQueue[(msgHead + k) % MSGQUEUE];
+    if ((q.targets & targets) != 0){
+      q.targets &= ~targets;
+      if (q.targets == 0){
+        msgStats.coalesced++;
+      }
+    }
+  }
+  // Close the gaps of replaced messages, drop the oldest message if the queue is still full
+  if (msgCount == MSGQUEUE){
+    uint8_t n = 0;
+    for (uint8_t k = 0; k < msgCount; k++){
+      QueuedMsg &q = msgQueue[(msgHead + k) % MSGQUEUE];
+      if (q.targets == 0){
+        continue;
+      }
+      if (n != k){
+        msgMove(msgQueue[(msgHead + n) % MSGQUEUE], q);
+      }
+      n++;
+    }
+    msgCount = n;
+  }
+  if (msgCount == MSGQUEUE){
+    msgHead = (msgHead + 1) % MSGQUEUE;
+    msgCount--;
+    msgStats.dropped++;
+  }
+  // Copy the fields, cut to the size of the display state
+  QueuedMsg &q = msgQueue[(msgHead + msgCount) % MSGQUEUE];
+  char *b = q.buf;
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    uint16_t len = (msg.field[f].len < msgFieldLen[f]) ? msg.field[f].len : msgFieldLen[f];
+    memcpy(b, msg.field[f].ptr, len);
+    q.msg.field[f].ptr = b;
+    q.msg.field[f].len = len;
+    b += len;
+  }
+  q.msg.count = msg.count;
+  q.targets = targets;
+  msgCount++;
+  msgStats.enqueued++;
+  if (msgCount > msgStats.highWater){
+    msgStats.highWater = msgCount;
+  }
 }
 
 
-// NTP time updater
-void updateTime()
+// Apply all queued messages to the state of their displays, returns the displays changed
+DispMask msgDrain()
 {
-  time(&now);                         // read the current time
-  localtime_r(&now, &tm);             // update the structure tm with the current time
-
-  if (millis() - lastNTP < 20000){
-    // Format time, add leading 0's
-    ntptime = ("0" + String(tm.tm_hour)).substring( String(tm.tm_hour).length() - 1,  String(tm.tm_hour).length() +1) + ":" + ("0" + String(tm.tm_min)).substring( String(tm.tm_min).length() - 1,  String(tm.tm_min).length() +1);
-    ntpdate = ("0" + String(tm.tm_mday)).substring( String(tm.tm_mday).length() - 1,  String(tm.tm_mday).length() +1) + "." + ("0" + String(tm.tm_mon + 1)).substring( String(tm.tm_mon + 1).length() - 1, String(tm.tm_mon + 1).length() + 1) + "." + String(tm.tm_year + 1900);
-    lastNTP = millis();
-  }
-  else {
-    ntptime = "no NTP time";
+  DispMask changed = 0;
+  for (; msgCount > 0; msgCount--){
+    QueuedMsg &q = msgQueue[msgHead];
+    const ZZASpan *f = q.msg.field;
+    changed |= q.targets;
+    for (DispMask targets = q.targets; targets != 0; targets &= targets - 1){
+      uint8_t i = __builtin_ctz(targets);
+      setField(ZZA[i].Targets, sizeof(ZZA[i].Targets), f[ZZAF_TARGETS].ptr, f[ZZAF_TARGETS].len);
+      ZZA[i].Template = zzaTemplate(f[ZZAF_TEMPLATE]);   // fields in the queue are not null terminated
+      setField(ZZA[i].Station, sizeof(ZZA[i].Station), f[ZZAF_STATION].ptr, f[ZZAF_STATION].len);
+      if (f[ZZAF_TRACK].len == 1 && f[ZZAF_TRACK].ptr[0] == '-'){
+        strlcpy(ZZA[i].Track, DPL_track[i], sizeof(ZZA[i].Track));
+      }
+      else {
+        setField(ZZA[i].Track, sizeof(ZZA[i].Track), f[ZZAF_TRACK].ptr, f[ZZAF_TRACK].len);
+      }
+      setField(ZZA[i].Destination, sizeof(ZZA[i].Destination), f[ZZAF_DESTINATION].ptr, f[ZZAF_DESTINATION].len);
+      setField(ZZA[i].DepartureO, sizeof(ZZA[i].DepartureO), f[ZZAF_DEPARTURE].ptr, f[ZZAF_DEPARTURE].len);
+      setField(ZZA[i].Train, sizeof(ZZA[i].Train), f[ZZAF_TRAIN].ptr, f[ZZAF_TRAIN].len);
+      // A TrainType longer than a logo ID has no logo, cut it would select the logo of its first characters
+      if (f[ZZAF_TYPE].len < ZZA_TYPELEN){
+        setField(ZZA[i].Type, sizeof(ZZA[i].Type), f[ZZAF_TYPE].ptr, f[ZZAF_TYPE].len);
+      }
+      else {
+        ZZA[i].Type[0] = '\0';
+      }
+      ZZA[i].logo = logoFind(ZZA[i].Type);
+      setField(ZZA[i].MessageO, sizeof(ZZA[i].MessageO), f[ZZAF_MESSAGE].ptr, f[ZZAF_MESSAGE].len);
+      compileDisplayVars(i);
+      updDisplayVar(i);
+      ZZA[i].version++;
+    }
+    msgHead = (msgHead + 1) % MSGQUEUE;
   }
-  //Serial.print(ntptime);
-  //if (tm.tm_isdst == 1)                  // Daylight Saving Time flag
-  //  Serial.println("\t  Daylight Saving Time");
-  //else
-  //  Serial.println("\t  Standard Time");
+  return changed;
 }
 
 
-// Update time and date variables in displayed messages
-void updVar()
-{
-  if(strlen(config.MQTT_TOPIC1) == 0){
-    rrtime = ntptime;
-    rrdate = ntpdate;
-  }
-  ZZA1_Message = ZZA1_MessageO;
-  ZZA1_Message.replace("{ntptime}", ntptime);
-  ZZA1_Message.replace("{ntpdate}", ntpdate);
-  ZZA1_Message.replace("{rrtime}", rrtime);
-  ZZA1_Message.replace("{rrdate}", rrdate);
-  ZZA1_MessageLoop = " +++ " + ZZA1_Message;
-  width1 = disp.getUTF8Width(ZZA1_MessageLoop.c_str());
-  ZZA1_Departure = ZZA1_DepartureO;
-  ZZA1_Departure.replace("{rrtime}", rrtime);
-
-  ZZA2_Message = ZZA2_MessageO;
-  ZZA2_Message.replace("{ntptime}", ntptime);
-  ZZA2_Message.replace("{ntpdate}", ntpdate);
-  ZZA2_Message.replace("{rrtime}", rrtime);
-  ZZA2_Message.replace("{rrdate}", rrdate);
-  ZZA2_MessageLoop = " +++ " + ZZA2_Message;
-  width2 = disp.getUTF8Width(ZZA2_MessageLoop.c_str());
-  ZZA2_Departure = ZZA2_DepartureO;
-  ZZA2_Departure.replace("{rrtime}", rrtime);
-
-  ZZA3_Message = ZZA3_MessageO;
-  ZZA3_Message.replace("{ntptime}", ntptime);
-  ZZA3_Message.replace("{ntpdate}", ntpdate);
-  ZZA3_Message.replace("{rrtime}", rrtime);
-  ZZA3_Message.replace("{rrdate}", rrdate);
-  ZZA3_MessageLoop = " +++ " + ZZA3_Message;
-  width3 = disp.getUTF8Width(ZZA3_MessageLoop.c_str());
-  ZZA3_Departure = ZZA3_DepartureO;
-  ZZA3_Departure.replace("{rrtime}", rrtime);
-
-  ZZA4_Message = ZZA4_MessageO;
-  ZZA4_Message.replace("{ntptime}", ntptime);
-  ZZA4_Message.replace("{ntpdate}", ntpdate);
-  ZZA4_Message.replace("{rrtime}", rrtime);
-  ZZA4_Message.replace("{rrdate}", rrdate);
-  ZZA4_MessageLoop = " +++ " + ZZA4_Message;
-  width4 = disp.getUTF8Width(ZZA4_MessageLoop.c_str());
-  ZZA4_Departure = ZZA4_DepartureO;
-  ZZA4_Departure.replace("{rrtime}", rrtime);
-
-  ZZA5_Message = ZZA5_MessageO;
-  ZZA5_Message.replace("{ntptime}", ntptime);
-  ZZA5_Message.replace("{ntpdate}", ntpdate);
-  ZZA5_Message.replace("{rrtime}", rrtime);
-  ZZA5_Message.replace("{rrdate}", rrdate);
-  ZZA5_MessageLoop = " +++ " + ZZA5_Message;
-  width5 = disp.getUTF8Width(ZZA5_MessageLoop.c_str());
-  ZZA5_Departure = ZZA5_DepartureO;
-  ZZA5_Departure.replace("{rrtime}", rrtime);
-
-  ZZA6_Message = ZZA6_MessageO;
-  ZZA6_Message.replace("{ntptime}", ntptime);
-  ZZA6_Message.replace("{ntpdate}", ntpdate);
-  ZZA6_Message.replace("{rrtime}", rrtime);
-  ZZA6_Message.replace("{rrdate}", rrdate);
-  ZZA6_MessageLoop = " +++ " + ZZA6_Message;
-  width6 = disp.getUTF8Width(ZZA6_MessageLoop.c_str());
-  ZZA6_Departure = ZZA6_DepartureO;
-  ZZA6_Departure.replace("{rrtime}", rrtime);
-
-  ZZA7_Message = ZZA7_MessageO;
-  ZZA7_Message.replace("{ntptime}", ntptime);
-  ZZA7_Message.replace("{ntpdate}", ntpdate);
-  ZZA7_Message.replace("{rrtime}", rrtime);
-  ZZA7_Message.replace("{rrdate}", rrdate);
-  ZZA7_MessageLoop = " +++ " + ZZA7_Message;
-  width7 = disp.getUTF8Width(ZZA7_MessageLoop.c_str());
-  ZZA7_Departure = ZZA7_DepartureO;
-  ZZA7_Departure.replace("{rrtime}", rrtime);
-
-  ZZA8_Message = ZZA8_MessageO;
-  ZZA8_Message.replace("{ntptime}", ntptime);
-  ZZA8_Message.replace("{ntpdate}", ntpdate);
-  ZZA8_Message.replace("{rrtime}", rrtime);
-  ZZA8_Message.replace("{rrdate}", rrdate);
-  ZZA8_MessageLoop = " +++ " + ZZA8_Message;
-  width8 = disp.getUTF8Width(ZZA8_MessageLoop.c_str());
-  ZZA8_Departure = ZZA8_DepartureO;
-  ZZA8_Departure.replace("{rrtime}", rrtime);
+// Heap fragmentation in percent, 0 = all free heap is one contiguous block
+uint8_t heapFragmentation()
+{
+  #if defined(ESP8266)
+    return ESP.getHeapFragmentation();
+  #elif defined(ESP32)
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap == 0){
+      return 0;
+    }
+    return 100 - (uint8_t)((uint64_t)ESP.getMaxAllocHeap() * 100 / freeHeap);
+  #else
+    return 0;
+  #endif
 }
 
 
 // Initialize/End Demo Mode
 void DemoModeOn()
 {
-  if (demonum >= 12){
+  if (demonum >= 13){
     config.DEMO = 0;
     tS9.disable();
     Serial.println(F("\nDemo Mode OFF"));
@@ -1992,6 +2144,17 @@ void DemoTimeOn()
 }
 
 
+// IDs of up to count displays, starting with display first + 1 and then every step
+String demoTargets(uint8_t first, uint8_t step, uint8_t count)
+{
+  String targets = "";
+  for (uint8_t i = first; i < MAXDISP && count > 0; i += step, count--){
+    targets += DPL_id[i];
+  }
+  return targets;
+}
+
+
 // Demo Mode
 void DemoMode()
 {
@@ -2000,49 +2163,53 @@ void DemoMode()
   switch (demonum){
     // Demo Mode Message
     case 1: demomsg = "DEMO ZZAMSG#Targets#T6#Demo Mode#########....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Normal train announcement
     case 2: demomsg = "DEMO ZZAMSG#Targets#T0#Bhf01#Track#Hamburg-Hbf#08:17#ICE597#ICE####....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]) + String(DPL_id[2]) + String(DPL_id[3]) + String(DPL_id[4]) + String(DPL_id[5]) + String(DPL_id[6]) + String(DPL_id[7]));
+            demomsg.replace("Targets", demoTargets(0, 1, MAXDISP));
             demomsg.replace("Track", String(DPL_track[0]));
             break;
     // Announcement with scroll message
     case 3: demomsg = "DEMO ZZAMSG#Targets#T0#Bhf01#Track#Hamburg-Hbf#08:17#ICE 597#ICE#Abfahrt heute auf Gleis 4###....";
-            demomsg.replace("Targets", String(DPL_id[1]) + String(DPL_id[3]) + String(DPL_id[5]) + String(DPL_id[7]));
-            demomsg.replace("Track", String(DPL_track[1]));
+            demomsg.replace("Targets", demoTargets(1, 2, MAXDISP));
+            demomsg.replace("Track", String(DPL_track[(MAXDISP > 1) ? 1 : 0]));
             break;
     // Warning
     case 4: demomsg = "DEMO ZZAMSG#Targets#T5#######Zugdurchfahrt###....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // NTP Time
     case 5: demomsg = "DEMO ZZAMSG#Targets#T4#######{ntptime}###....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Railroad Time
     case 6: demomsg = "DEMO ZZAMSG#Targets#T4#######{rrtime}###....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Message
     case 7: demomsg = "DEMO ZZAMSG#Targets#T0#Bhf01#1#Köln-Bonn#10:22#RE7#RE#5min Verspätung - 5min delayed###....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Local train S-Bahn
     case 8: demomsg = "DEMO ZZAMSG#Targets#T2#Bhf01#5#Stellingen#16:43#S21#S####....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Station Name
     case 9: demomsg = "DEMO ZZAMSG#Targets#T6#Gartenstadt#########....";
-            demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+            demomsg.replace("Targets", demoTargets(0, 1, 2));
             break;
     // Scrolltext only
     case 10: demomsg = "DEMO ZZAMSG#Targets#T9##2#####Ersatzfahrplan wg. Bahnstreik###....";
-             demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]));
+             demomsg.replace("Targets", demoTargets(0, 1, 2));
+             break;
+    // Track without station name
+    case 11: demomsg = "DEMO ZZAMSG#Targets#T2##3#Altona#17:05#S3#S####....";
+             demomsg.replace("Targets", demoTargets(0, 1, 2));
              break;
     // Clear all displays
-    case 11: demomsg = "DEMO ZZAMSG#Targets###########....";
-             demomsg.replace("Targets", String(DPL_id[0]) + String(DPL_id[1]) + String(DPL_id[2]) + String(DPL_id[3]) + String(DPL_id[4]) + String(DPL_id[5]) + String(DPL_id[6]) + String(DPL_id[7]));
+    case 12: demomsg = "DEMO ZZAMSG#Targets###########....";
+             demomsg.replace("Targets", demoTargets(0, 1, MAXDISP));
              break;
   }
   if (config.MQTT_DEBUG == 1){
@@ -2052,7 +2219,189 @@ void DemoMode()
     Serial.println(demomsg);
   }
   demonum +=1;
-  client.publish(config.MQTT_TOPIC2, demomsg, false);
+  if (config.MQTT_ROUTE == 2){
+    client.publish(String("rmd/") + config.WIFI_DEVICENAME + "/demo", demomsg, false);
+  }
+  else {
+    client.publish(config.MQTT_TOPIC2, demomsg, false);
+  }
+}
+
+
+// Split a received payload into its messages, ZZAMSG, ZZABATCH or ZZAMSG v2, and pass each message to handle.
+// Returns the number of messages, reading stops at the first invalid message.
+uint8_t readMessages(const String &payload, void (*handle)(ZZAMsg &msg))
+{
+  const char *buf = payload.c_str();
+  const char *end = buf + payload.length();
+  ZZAMsg msg;
+  uint8_t n = 0;
+  if (zza2Is(buf, payload.length())){
+    // ZZAMSG v2, the payload consists of messages only
+    if (config.MQTT_DEBUG == 1){
+      Serial.printf("Received ZZAMSG v2: %u bytes\n", payload.length());
+    }
+    for (const char *s = buf + 2; s < end; n++){
+      s = zza2Parse(s, end, msg);
+      if (s == nullptr){
+        break;
+      }
+      handle(msg);
+    }
+    return n;
+  }
+  // Payload from the ZZAMSG identifier up to the last 4 characters, a ZZABATCH payload carries several ZZAMSG records
+  const char *p = strstr(buf, "ZZAMSG");
+  const char *batch = strstr(buf, "ZZABATCH");
+  end = (p == nullptr) ? buf : (end - p > 4) ? end - 4 : p;
+  if (config.MQTT_DEBUG == 1){
+    Serial.println("Received message:  " + payload);
+    if (p != nullptr){
+      Serial.printf("Received payload:  %.*s\n", (int)(end - p), p);
+    }
+  }
+  while (p != nullptr && p < end){
+    size_t len = (batch != nullptr && batch < p) ? zzaBatchRecord(p, end) : end - p;
+    if (!zzaParse(p, len, config.MQTT_DELIMITER, msg)){
+      break;
+    }
+    if (config.MQTT_DEBUG == 1){
+      Serial.printf("Payload fields:    %u\n", msg.count);
+    }
+    handle(msg);
+    n++;
+    p += len;
+  }
+  return n;
+}
+
+
+// Messages received on Topic2 or the topics of this controller and its displays.
+// All messages of a payload are queued together and shown in the same frame.
+void receiveMessages(const String &payload)
+{
+  TimingScope timed(timing[TM_ZZAMSG]);
+  StateLock lock;
+  msgStats.payloads++;
+  if (readMessages(payload, [](ZZAMsg &msg) { msgEnqueue(msg, msgTargets(msg)); }) > 0){
+    // Deactivate / Reset ScreenSaver
+    screenSaver(0);
+    lastMsg = millis();
+  }
+  else {
+    Serial.println(F("Error - No valid ZZAMSG Message"));
+    Serial.println(payload);
+  }
+}
+
+
+// Router, forward the messages received on Topic2 to the topics of their displays.
+// All messages of a payload for one display ID are published together and shown in the same frame, see routeFlush().
+void routeMessages(const String &payload)
+{
+  TimingScope timed(timing[TM_ZZAMSG]);
+  msgStats.payloads++;
+  routeCount = 0;
+  if (readMessages(payload, routeMessage) == 0){
+    Serial.println(F("Error - No valid ZZAMSG Message"));
+    Serial.println(payload);
+  }
+  routeFlush();
+}
+
+
+// Collect a message for routeFlush(), fields are cut to the size of the display state
+void routeMessage(ZZAMsg &msg)
+{
+  if (routeCount == MSGQUEUE){
+    routeFlush();
+  }
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    if (msg.field[f].len > msgFieldLen[f]){
+      msg.field[f].len = msgFieldLen[f];
+    }
+  }
+  routeMsg[routeCount++] = msg;
+}
+
+
+// True if the Targets field targets contains the display ID id
+bool routeHas(const ZZASpan &targets, const char *id, uint16_t len)
+{
+  const char *end = targets.ptr + targets.len;
+  for (const char *s = targets.ptr; s < end; ){
+    const char *t;
+    s = targetNext(s, end, t);
+    if (s - t == len && memcmp(t, id, len) == 0){
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Publish the collected messages as ZZAMSG v2 to rmd/display/<ID>, one payload per display ID with all its messages
+// separated by ZZA2_NEXT. Only messages that don't fit into one MQTT packet of MQTT_MSGSIZE go into a further payload.
+void routeFlush()
+{
+  static char out[MSGQLEN + 2 * ZZAF_COUNT + 3];
+  char topic[sizeof("rmd/display/") + ZZA_IDSLEN];
+  for (uint8_t k = 0; k < routeCount; k++){
+    const ZZASpan targets = routeMsg[k].field[ZZAF_TARGETS];
+    const char *end = targets.ptr + targets.len;
+    for (const char *s = targets.ptr; s < end; ){
+      const char *id;
+      s = targetNext(s, end, id);
+      uint16_t len = s - id;
+      // Every display ID once, with its first message
+      bool seen = (len == 0) || routeHas({ targets.ptr, (uint16_t)(id - targets.ptr) }, id, len);
+      for (uint8_t j = 0; j < k && !seen; j++){
+        seen = routeHas(routeMsg[j].field[ZZAF_TARGETS], id, len);
+      }
+      if (seen){
+        continue;
+      }
+      snprintf(topic, sizeof(topic), "rmd/display/%.*s", (int)len, id);
+      // Payload room in an MQTT packet, PubSubClient needs topic + payload + 9 below its buffer size. zza2Encode() returns
+      // less than the room, the null termination isn't sent.
+      size_t header = 9 + strlen(topic);
+      size_t room = (config.MQTT_MSGSIZE > header) ? min(sizeof(out), (size_t)(config.MQTT_MSGSIZE - header)) : 0;
+      size_t n = 0;
+      uint8_t count = 0;
+      for (uint8_t j = k; j < routeCount; j++){
+        if (!routeHas(routeMsg[j].field[ZZAF_TARGETS], id, len)){
+          continue;
+        }
+        ZZAMsg msg = routeMsg[j];
+        msg.mask = 0;
+        msg.field[ZZAF_TARGETS] = { id, len };
+        size_t l = zza2Encode(msg, out + n, room - n);
+        if (l == 0 && n > 0){
+          client.publish(topic, out, false);
+          msgStats.forwarded += count;
+          n = 0;
+          count = 0;
+          l = zza2Encode(msg, out, room);
+        }
+        if (l == 0){
+          msgStats.dropped++;
+          continue;
+        }
+        // The magic byte and version of a following message become its ZZA2_NEXT record
+        if (n > 0){
+          out[n] = (char)(0x20 + ZZA2_NEXT);
+          out[n + 1] = (char)0x20;
+        }
+        n += l;
+        count++;
+      }
+      if (n > 0){
+        client.publish(topic, out, false);
+        msgStats.forwarded += count;
+      }
+    }
+  }
+  routeCount = 0;
 }
 
 
@@ -2082,8 +2431,19 @@ void onConnectionEstablished()
   if (client.isMqttConnected() == true){
     Serial.println((String)"\nMQTT broker successfully connected at " + config.MQTT_IP + ":" + config.MQTT_PORT + "\n");
   }
+  // Publish the boot timeline on the first connection
+  static bool bootPublished = false;
+  if (!bootPublished){
+    bootPublished = true;
+    {
+      StateLock lock;
+      bootMark("mqtt", micros());
+    }
+    client.publish("rmnet/boot", bootJson(), false);
+  }
   // Subscribe MQTT client to topic: "rmnet/#"
   client.subscribe("rmnet/#", [](const String & payload0){
+    TimingScope timed(timing[TM_RMNET]);
     if (config.MQTT_DEBUG == 1){
       Serial.println("Received message from rmnet:  " + payload0);
     }
@@ -2098,376 +2458,66 @@ void onConnectionEstablished()
 
   // Subscribe to MQTT TOPIC1 to receive Model Railroad Time or Demo Time, default topic "rocrail/service/info/clock"
   if(strlen(config.MQTT_TOPIC1) != 0){
-    tS11.disable();  //disable NTP Time only mode
-    client.subscribe(config.MQTT_TOPIC1, [](const String & payload1in) {
-      //Serial.println(payload1in);
-      String payload1 = payload1in;
-      //Serial.println("Index of Sync1: " + String(payload1.indexOf("sync")));
+    client.subscribe(config.MQTT_TOPIC1, [](const String & payload1) {
+      TimingScope timed(timing[TM_CLOCK]);
       // RR Example: <clock divider="1" hour="18" minute="40" wday="5" mday="12" month="2" year="2021" time="1613151626" temp="20" bri="255" lux="0" pressure="0" humidity="0" cmd="sync"/>
-      //Serial.println("config.DEMO: " + String(config.DEMO));
-      //Serial.println("Index of Sync2: " + String(payload1.indexOf("sync")));
-      //Serial.println("Index of DEMO: " + String(payload1.indexOf("DEMO")));
-      if (config.DEMO == 1 && payload1.indexOf("sync") > -1){
-        payload1 = "";
-        //Serial.println("payload1 removed, not DEMO: " + payload1);
+      const char *p = payload1.c_str();
+      bool sync = strstr(p, "sync") != nullptr;
+      bool demo = strstr(p, "DEMO") != nullptr;
+      // Ignore railroad time in Demo Mode and messages that are neither railroad nor demo time
+      if ((config.DEMO == 1 && sync) || (!sync && !demo)){
+        return;
       }
-      else if (payload1.indexOf("sync") == -1 && payload1.indexOf("DEMO") == -1){
-        //Serial.println("Index of Sync2: " + String(payload1.indexOf("sync")));
-        //Serial.println("Index of DEMO: " + String(payload1.indexOf("DEMO")));
-        //Serial.println("No RR and no Demo: " + payload1);
-        //rrtime = "00:00";
-        rrtime = rrtimelast;
-        //rrdate = "01.01.2000";
-        rrdate = rrdatelast;
+      RRClock c;
+      if (!rrClockParse(p, payload1.length(), c)){
+        return;
       }
-      else
-      {
-        String h = payload1.substring(payload1.indexOf("hour") + 6, payload1.indexOf("minute") - 2);
-        if (h.length() < 2){
-          h = "0" + h;
-        }
-        String m = payload1.substring(payload1.indexOf("minute") + 8, payload1.indexOf("wday") - 2);
-        if (m.length() < 2){
-          m = "0" + m;
-        }
-        uint8_t w = (payload1.substring(payload1.indexOf("wday") + 6, payload1.indexOf("mday") - 2)).toInt();
-        String wd = "";
-        switch (w) {
-          case 1: wd = "Mo";
-                  break;
-          case 2: wd = "Di";
-                  break;
-          case 3: wd = "Mi";
-                  break;
-          case 4: wd = "Do";
-                  break;
-          case 5: wd = "Fr";
-                  break;
-          case 6: wd = "Sa";
-                  break;
-          case 7: wd = "So";
-                  break;
-          }
-        String d = payload1.substring(payload1.indexOf("mday") + 6, payload1.indexOf("month") - 2);
-        if (d.length() < 2){
-          d = "0" + d;
-        }
-        String mo = payload1.substring(payload1.indexOf("month") + 7, payload1.indexOf("year") - 2);
-        if (mo.length() < 2){
-          mo = "0" + mo;
-        }
-        String y = payload1.substring(payload1.indexOf("year") + 6, payload1.indexOf("time") - 2);
-  
-        rrtime = h + ":" + m;
-        rrtimelast = rrtime;
-        rrdate = d + "." + mo + "." + y;
-        rrdatelast = rrdate;
+      // Room for any int16_t, rrClockParse() keeps the fields in range so time and date fit rrtime and rrdate
+      char t[16];
+      char d[24];
+      snprintf(t, sizeof(t), "%02d:%02d", c.hour, c.minute);
+      snprintf(d, sizeof(d), "%02d.%02d.%d", max(c.mday, (int16_t)0), max(c.month, (int16_t)0), max(c.year, (int16_t)0));
+      // Write the variables only when the shown minute or date changed, fast clocks send many messages
+      if (strcmp(t, rrtime) != 0 || strcmp(d, rrdate) != 0){
+        StateLock lock;
+        strlcpy(rrtime, t, sizeof(rrtime));
+        strlcpy(rrdate, d, sizeof(rrdate));
       }
-      updVar();
     }, 1);
   }
   else {
     Serial.println(F("MQTT Topic1 is empty, no model railroad time availabe!\nOnly {ntptime} can be used in messages to show current time on displays"));
-    tS11.enable();  // enable NTP Time/Date only mode when no railroad time is available
   }
 
   // Subscribe to MQTT TOPIC2 to receive messages sent by Model Railroad system text fields or other MQTT sources, default topic "rocrail/service/info/tx"
-  client.subscribe(config.MQTT_TOPIC2, [](const String & payload2) {
-    String pld = payload2.substring(payload2.indexOf("ZZAMSG"), payload2.length() - 4);
-    if (config.MQTT_DEBUG == 1){
-      Serial.println("Received message:  " + payload2);
-      Serial.println("Received payload:  " + pld);
-      //Serial.println(strlen(config.MQTT_DELIMITER));
-      //Serial.println(config.MQTT_DELIMITER);
-    }
-    if (pld.substring(0, 6) == "ZZAMSG"){
-      if (strlen(config.MQTT_DELIMITER) > 0){
-        pld.replace(String(config.MQTT_DELIMITER), "#");
-      }
-      if (config.MQTT_DEBUG == 1){
-        Serial.println("Converted payload: " + pld);
-      }
-      uint8_t start01 = pld.indexOf("ZZAMSG#") + 7;                         // ZZAMSG identifier
-      uint8_t start02 = start01 + 1 + pld.substring(start01).indexOf("#");  // Target Displays as defined in config.h e.g. D01-D08
-      uint8_t start03 = start02 + 1 + pld.substring(start02).indexOf("#");  // Template T0-T9
-      uint8_t start04 = start03 + 1 + pld.substring(start03).indexOf("#");  // Station Name
-      uint8_t start05 = start04 + 1 + pld.substring(start04).indexOf("#");  // Track Number
-      uint8_t start06 = start05 + 1 + pld.substring(start05).indexOf("#");  // Destination Name
-      uint8_t start07 = start06 + 1 + pld.substring(start06).indexOf("#");  // Departure Time
-      uint8_t start08 = start07 + 1 + pld.substring(start07).indexOf("#");  // Train Number
-      uint8_t start09 = start08 + 1 + pld.substring(start08).indexOf("#");  // Train Type e.g. ICE, IC, ...
-      uint8_t start10 = start09 + 1 + pld.substring(start09).indexOf("#");  // Message Text
-
-      // Deactivate / Reset ScreenSaver
-      screenSaver(0);
-      lastMsg = millis();
-
-      // Display 1
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[0]) != -1){
-        ZZA1_Targets = pld.substring(start01, start02 -1);
-        ZZA1_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA1_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA1_Track = DPL_track[0];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA1_Track = "";
-        }
-        else {
-          ZZA1_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA1_Destination = pld.substring(start05, start06 -1);
-        ZZA1_DepartureO = pld.substring(start06, start07 -1);
-        ZZA1_Departure = ZZA1_DepartureO;
-        ZZA1_Train = pld.substring(start07, start08 -1);
-        ZZA1_Type = pld.substring(start08, start09 -1);
-        ZZA1_MessageO = pld.substring(start09, start10 -1);
-        ZZA1_Message = ZZA1_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA1_Departure.replace("{rrtime}", rrtime);
-          ZZA1_Message.replace("{ntptime}", ntptime);
-          ZZA1_Message.replace("{ntpdate}", ntpdate);
-          ZZA1_Message.replace("{rrtime}", rrtime);
-          ZZA1_Message.replace("{rrdate}", rrdate);
-        }
-        ZZA1_MessageLoop = " +++ " + ZZA1_Message;
-        width1 = disp.getUTF8Width(ZZA1_MessageLoop.c_str());
-      }
-      
-      // Display 2
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[1]) != -1){
-        ZZA2_Targets = pld.substring(start01, start02 -1);
-        ZZA2_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA2_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA2_Track = DPL_track[1];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA2_Track = "";
-        }
-        else {
-          ZZA2_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA2_Destination = pld.substring(start05, start06 -1);
-        ZZA2_DepartureO = pld.substring(start06, start07 -1);
-        ZZA2_Departure = ZZA2_DepartureO;
-        ZZA2_Train = pld.substring(start07, start08 -1);
-        ZZA2_Type = pld.substring(start08, start09 -1);
-        ZZA2_MessageO = pld.substring(start09, start10 -1);
-        ZZA2_Message = ZZA2_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA2_Departure.replace("{rrtime}", rrtime);
-          ZZA2_Message.replace("{ntptime}", ntptime);
-          ZZA2_Message.replace("{ntpdate}", ntpdate);
-          ZZA2_Message.replace("{rrtime}", rrtime);
-          ZZA2_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA2_MessageLoop = " +++ " + ZZA2_Message;
-        width2 = disp.getUTF8Width(ZZA2_MessageLoop.c_str());
-      }
-
-      // Display 3
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[2]) != -1){
-        ZZA3_Targets = pld.substring(start01, start02 -1);
-        ZZA3_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA3_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA3_Track = DPL_track[2];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA3_Track = "";
-        }
-        else {
-          ZZA3_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA3_Destination = pld.substring(start05, start06 -1);
-        ZZA3_DepartureO = pld.substring(start06, start07 -1);
-        ZZA3_Departure = ZZA3_DepartureO;
-        ZZA3_Train = pld.substring(start07, start08 -1);
-        ZZA3_Type = pld.substring(start08, start09 -1);
-        ZZA3_MessageO = pld.substring(start09, start10 -1);
-        ZZA3_Message = ZZA3_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA3_Departure.replace("{rrtime}", rrtime);
-          ZZA3_Message.replace("{ntptime}", ntptime);
-          ZZA3_Message.replace("{ntpdate}", ntpdate);
-          ZZA3_Message.replace("{rrtime}", rrtime);
-          ZZA3_Message.replace("{rrdate}", rrdate);
-        }
-        ZZA3_MessageLoop = " +++ " + ZZA3_Message;
-        width3 = disp.getUTF8Width(ZZA3_MessageLoop.c_str());
-      }
-
-      // Display 4
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[3]) != -1){
-        ZZA4_Targets = pld.substring(start01, start02 -1);
-        ZZA4_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA4_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA4_Track = DPL_track[3];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA4_Track = "";
-        }
-        else {
-          ZZA4_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA4_Destination = pld.substring(start05, start06 -1);
-        ZZA4_DepartureO = pld.substring(start06, start07 -1);
-        ZZA4_Departure = ZZA4_DepartureO;
-        ZZA4_Train = pld.substring(start07, start08 -1);
-        ZZA4_Type = pld.substring(start08, start09 -1);
-        ZZA4_MessageO = pld.substring(start09, start10 -1);
-        ZZA4_Message = ZZA4_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA4_Departure.replace("{rrtime}", rrtime);
-          ZZA4_Message.replace("{ntptime}", ntptime);
-          ZZA4_Message.replace("{ntpdate}", ntpdate);
-          ZZA4_Message.replace("{rrtime}", rrtime);
-          ZZA4_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA4_MessageLoop = " +++ " + ZZA4_Message;
-        width4 = disp.getUTF8Width(ZZA4_MessageLoop.c_str());
-      }
+  // As router forward them to the display topics instead
+  if (config.MQTT_ROUTE == 3){
+    client.subscribe(config.MQTT_TOPIC2, routeMessages, 1);
+  }
+  else if (config.MQTT_ROUTE != 2){
+    client.subscribe(config.MQTT_TOPIC2, receiveMessages, 1);
+  }
 
-      // Display 5
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[4]) != -1){
-        ZZA5_Targets = pld.substring(start01, start02 -1);
-        ZZA5_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA5_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA5_Track = DPL_track[4];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA5_Track = "";
-        }
-        else {
-          ZZA5_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA5_Destination = pld.substring(start05, start06 -1);
-        ZZA5_DepartureO = pld.substring(start06, start07 -1);
-        ZZA5_Departure = ZZA5_DepartureO;
-        ZZA5_Train = pld.substring(start07, start08 -1);
-        ZZA5_Type = pld.substring(start08, start09 -1);
-        ZZA5_MessageO = pld.substring(start09, start10 -1);
-        ZZA5_Message = ZZA5_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA5_Departure.replace("{rrtime}", rrtime);
-          ZZA5_Message.replace("{ntptime}", ntptime);
-          ZZA5_Message.replace("{ntpdate}", ntpdate);
-          ZZA5_Message.replace("{rrtime}", rrtime);
-          ZZA5_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA5_MessageLoop = " +++ " + ZZA5_Message;
-        width5 = disp.getUTF8Width(ZZA5_MessageLoop.c_str());
+  // Subscribe to the topics of this controller and its displays, the broker delivers only messages for this controller
+  if (config.MQTT_ROUTE > 0){
+    client.subscribe(String("rmd/") + config.WIFI_DEVICENAME + "/#", receiveMessages, 1);
+    for (uint8_t i = 0; i < config.NUMDISP; i++){
+      bool known = false;
+      for (uint8_t k = 0; k < i; k++){
+        known = known || strcmp(DPL_id[k], DPL_id[i]) == 0;
       }
-
-      // Display 6
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[5]) != -1){
-        ZZA6_Targets = pld.substring(start01, start02 -1);
-        ZZA6_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA6_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA6_Track = DPL_track[5];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA6_Track = "";
-        }
-        else {
-          ZZA6_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA6_Destination = pld.substring(start05, start06 -1);
-        ZZA6_DepartureO = pld.substring(start06, start07 -1);
-        ZZA6_Departure = ZZA6_DepartureO;
-        ZZA6_Train = pld.substring(start07, start08 -1);
-        ZZA6_Type = pld.substring(start08, start09 -1);
-        ZZA6_MessageO = pld.substring(start09, start10 -1);
-        ZZA6_Message = ZZA6_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA6_Departure.replace("{rrtime}", rrtime);
-          ZZA6_Message.replace("{ntptime}", ntptime);
-          ZZA6_Message.replace("{ntpdate}", ntpdate);
-          ZZA6_Message.replace("{rrtime}", rrtime);
-          ZZA6_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA6_MessageLoop = " +++ " + ZZA6_Message;
-        width6 = disp.getUTF8Width(ZZA6_MessageLoop.c_str());
-      }
-
-      // Display 7
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[6]) != -1){
-        ZZA7_Targets = pld.substring(start01, start02 -1);
-        ZZA7_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA7_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA7_Track = DPL_track[6];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA7_Track = "";
-        }
-        else {
-          ZZA7_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA7_Destination = pld.substring(start05, start06 -1);
-        ZZA7_DepartureO = pld.substring(start06, start07 -1);
-        ZZA7_Departure = ZZA7_DepartureO;
-        ZZA7_Train = pld.substring(start07, start08 -1);
-        ZZA7_Type = pld.substring(start08, start09 -1);
-        ZZA7_MessageO = pld.substring(start09, start10 -1);
-        ZZA7_Message = ZZA7_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA7_Departure.replace("{rrtime}", rrtime);
-          ZZA7_Message.replace("{ntptime}", ntptime);
-          ZZA7_Message.replace("{ntpdate}", ntpdate);
-          ZZA7_Message.replace("{rrtime}", rrtime);
-          ZZA7_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA7_MessageLoop = " +++ " + ZZA7_Message;
-        width7 = disp.getUTF8Width(ZZA7_MessageLoop.c_str());
-      }
-
-      // Display 8
-      if (pld.substring(start01, start02 -1).indexOf(DPL_id[7]) != -1){
-        ZZA8_Targets = pld.substring(start01, start02 -1);
-        ZZA8_Template = pld.substring(start02 + 1, start03 -1);
-        ZZA8_Station = pld.substring(start03, start04 -1);
-        if(pld.substring(start04, start05 -1) == "-"){
-          ZZA8_Track = DPL_track[7];
-        }
-        else if (pld.substring(start04, start05 -1) == ""){
-          ZZA8_Track = "";
-        }
-        else {
-          ZZA8_Track = pld.substring(start04, start05 -1);
-        }
-        ZZA8_Destination = pld.substring(start05, start06 -1);
-        ZZA8_DepartureO = pld.substring(start06, start07 -1);
-        ZZA8_Departure = ZZA8_DepartureO;
-        ZZA8_Train = pld.substring(start07, start08 -1);
-        ZZA8_Type = pld.substring(start08, start09 -1);
-        ZZA8_MessageO = pld.substring(start09, start10 -1);
-        ZZA8_Message = ZZA8_MessageO;
-        if (pld.indexOf("{") > 0){
-          ZZA8_Departure.replace("{rrtime}", rrtime);
-          ZZA8_Message.replace("{ntptime}", ntptime);
-          ZZA8_Message.replace("{ntpdate}", ntpdate);
-          ZZA8_Message.replace("{rrtime}", rrtime);
-          ZZA8_Message.replace("{rrdate}", rrdate);
-        }        
-        ZZA8_MessageLoop = " +++ " + ZZA8_Message;
-        width8 = disp.getUTF8Width(ZZA8_MessageLoop.c_str());
+      if (!known && strlen(DPL_id[i]) > 0){
+        client.subscribe(String("rmd/display/") + DPL_id[i], receiveMessages, 1);
       }
     }
-    else {
-      Serial.println(F("Error - No valid ZZAMSG Message"));
-      Serial.println(pld);
-    }
-  }, 1);
+  }
 }
 
 
 void coreLoop()
 {
+  TimingScope timed(timing[TM_CORE]);
+  timingSchedule(timing[TM_CORE], tSc.getOverrun(), tSc.getStartDelay());
   if (config.MQTT_DEBUG == 1){
     Serial.print(F(" tSc: overrun = "));
     Serial.println(tSc.getOverrun());
@@ -2483,6 +2533,10 @@ void coreLoop()
   if ( millis() > (lastMsg + (config.SCREENSAVER * 60000)) && config.SCREENSAVER > 0 ){
     screenSaver(1);          // Activate ScreenSaver
   }
+
+  if (bootDeferred && (bootShown || millis() > BOOTDEFER)){
+    bootFinish();            // Fast boot: save configuration and snapshot
+  }
 }
 
 
@@ -6,6 +6,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 #include "template.h"         // Roc-MQTT-Display template file
+#include "logos.h"            // Roc-MQTT-Display logo registry
 #include <FS.h>
 #include <LittleFS.h>         // LittleFS file system https://github.com/esp8266/Arduino/tree/master/libraries/LittleFS
 #include <ArduinoJson.h>      // ArduinoJson by Benoît Blanchon https://github.com/bblanchon/ArduinoJson
@@ -47,6 +48,7 @@ struct Config {
   char     MQTT_TOPIC1[50];        // MQTT Topic 1, Railroad Time, default = "rocrail/service/info/clock"
   char     MQTT_TOPIC2[50];        // MQTT Topic 1, Railroad Messages, default = "rocrail/service/info/tx"
   char     MQTT_DELIMITER[5];      // MQTT delimiter (e.g. ";" or " , " for message payload, will be replaced by "#" before processing. Default: "#"
+  uint8_t  MQTT_ROUTE;             // Message topics, 0=Topic2, 1=Topic2 + rmd/<WIFI_DEVICENAME>/# + rmd/display/<DPL_id>, 2=rmd topics only, 3=router, default = 0
 // DISPLAYS
   //uint8_t  DISPSIZE = 0;           // 0=128x32, 1=128x64, 2=64x48, 3=96x16, 4=80x160, default = 0
   uint8_t  DISPWIDTH;              // Display width in pixel
@@ -54,24 +56,36 @@ struct Config {
   uint8_t  MUX;                    // TCA9548A I2C Multiplexer address, default: 112 (0x70), 0=one display connected without multiplexer
   uint8_t  NUMDISP;                // Number of I2C OLED displays connected to this controller, 1-8
   uint16_t STARTDELAY;             // Show Controllername and Display Number x milliseconds longer at startup, helpful during setup
+  uint8_t  FASTBOOT;               // When 1: Start all displays with one combined splash and defer non-essential work until the first message is shown, default: 0
   uint16_t UPDSPEED;               // Slow down display update intervall by increasing the number, e.g. 30 = base speed + 30ms
   uint8_t  SCREENSAVER;            // minutes without MQTT message received until screenSaver switches all displays into power save mode, 0=off
-  uint8_t  PRINTBUF;               // When 1: Print display buffer of display 1 to serial out as XBM, default: 0
+  uint16_t LOGORAM;                // RAM budget in bytes for logos loaded from logodir, default: 4096
+  uint8_t  PRINTBUF;               // When 1: Print display buffer of all displays to serial out as XBM, default: 0
 };
 Config config;
 
-// Configuration for displays connected to this controller (Disp) 1-8
-//                              Disp1, Disp2, Disp3, Disp4, Disp5, Disp6, Disp7, Disp8
-char     DPL_id[8][4] =       { "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08" };  // ID's of Displays 1-8 connected to this controller, e.g. D01...D99
-char     DPL_station[8][12] = {    "",    "",    "",    "",    "",    "",    "",    "" };  // Station, where the display is installed, e.g. Hamburg, Köln, Amsterd, Wien, ...
-char     DPL_track[8][4] =    {     1,     1,     1,     1,     1,     1,     1,     1 };  // 1...99, 1a, 1b track, where the display is installed
-uint8_t  DPL_flip[] =         {     0,     0,     0,     0,     0,     0,     0,     0 };  // 0,1  180 degree hardware based rotation of the internal frame buffer when 1
-uint8_t  DPL_contrast[] =     {    50,    50,    50,    50,    50,    50,    50,    50 };  // 0-255  0=display off (works with some displays only), default = 1, 255 max brightness, change requires reboot
-uint8_t  DPL_side[] =         {     0,     0,     0,     0,     0,     0,     0,     0 };  // 0,1  0=Side A, 1=Side B
+// Max. number of displays connected to this controller, 8 per TCA9548A multiplexer.
+// Displays 9-16 need a second multiplexer at the next I2C address (MUX + 1), and so on.
+#define MAXDISP 8
+
+// ESP32 only: 1 = draw and send the displays in a FreeRTOS task on the second core, MQTT, webserver and OTA
+// keep running in loop() on the other core. ESP8266 always draws the displays in loop().
+#define RENDERTASK 0
+
+// Configuration for displays connected to this controller (Disp) 1-MAXDISP, loadConfiguration() sets the defaults.
+// The web form config.htm has fields for displays 1-8, set displays 9 and up in rmdcfg.txt.
+char     DPL_id[MAXDISP][4];         // ID's of displays connected to this controller, e.g. D01...D99, default D01, D02, ...
+char     DPL_station[MAXDISP][12];   // Station, where the display is installed, e.g. Hamburg, Köln, Amsterd, Wien, ...
+char     DPL_track[MAXDISP][4];      // 1...99, 1a, 1b track, where the display is installed, default 1
+uint8_t  DPL_flip[MAXDISP];          // 0,1  180 degree hardware based rotation of the internal frame buffer when 1
+uint8_t  DPL_contrast[MAXDISP];      // 0-255  0=display off (works with some displays only), default = 50, 255 max brightness
+uint8_t  DPL_side[MAXDISP];          // 0,1  0=Side A, 1=Side B
 
 const char *secfile      = "/rmdsec.txt";      // 8.3 filename
 const char *configfile   = "/rmdcfg.txt";
 const char *templatefile = "/rmdtpl.txt";
+const char *snapfile     = "/rmdsnap.bin";     // binary snapshot of the json files above, written when they are saved or when it is missing
+const char *logodir      = "/logos";           // logo files <TrainType>.xbm or <TrainType>.pbm, added to or replacing the logos of template.h
 
 const char *template00 = "/rmdtpl00.txt";
 const char *template01 = "/rmdtpl01.txt";
@@ -85,6 +99,14 @@ const char *template08 = "/rmdtpl08.txt";
 const char *template09 = "/rmdtpl09.txt";
 
 
+// Name of setting name of display i in rmdcfg.txt and the web form, e.g. DPL_TRACK0, stations have a two-digit index: DPL_STATION00
+char *dplKey(char *key, size_t len, const char *name, uint8_t i)
+{
+  snprintf(key, len, "DPL_%s%0*u", name, (strcmp(name, "STATION") == 0) ? 2 : 1, (unsigned int)i);
+  return key;
+}
+
+
 // Load configuration from file
 void loadConfiguration(const char *configfile, Config &config)
 {
@@ -121,63 +143,29 @@ void loadConfiguration(const char *configfile, Config &config)
   strlcpy(config.MQTT_TOPIC1, doc["MQTT_TOPIC1"] | "rocrail/service/info/clock", sizeof(config.MQTT_TOPIC1));
   strlcpy(config.MQTT_TOPIC2, doc["MQTT_TOPIC2"] | "rocrail/service/info/tx", sizeof(config.MQTT_TOPIC2));
   strlcpy(config.MQTT_DELIMITER, doc["MQTT_DELIMITER"] | "", sizeof(config.MQTT_DELIMITER));
+  config.MQTT_ROUTE = doc["MQTT_ROUTE"] | 0;
   config.MQTT_DEBUG = doc["MQTT_DEBUG"] | 0;
   config.MUX = doc["MUX"] | 112;
   config.NUMDISP = doc["NUMDISP"] | 2;
   config.DISPWIDTH = doc["DISPWIDTH"] | 128;
   config.DISPHEIGHT = doc["DISPHEIGHT"] | 32;
   config.STARTDELAY = doc["STARTDELAY"] | 200;
+  config.FASTBOOT = doc["FASTBOOT"] | 0;
   config.UPDSPEED = doc["UPDSPEED"] | 0;
   config.SCREENSAVER = doc["SCREENSAVER"] | 60;
+  config.LOGORAM = doc["LOGORAM"] | 4096;
   config.PRINTBUF = doc["PRINTBUF"] | 0;
-  strlcpy(DPL_id[0], doc["DPL_ID0"] | "D01", sizeof(DPL_id[0]));
-  strlcpy(DPL_id[1], doc["DPL_ID1"] | "D02", sizeof(DPL_id[1]));
-  strlcpy(DPL_id[2], doc["DPL_ID2"] | "D03", sizeof(DPL_id[2]));
-  strlcpy(DPL_id[3], doc["DPL_ID3"] | "D04", sizeof(DPL_id[3]));
-  strlcpy(DPL_id[4], doc["DPL_ID4"] | "D05", sizeof(DPL_id[4]));
-  strlcpy(DPL_id[5], doc["DPL_ID5"] | "D06", sizeof(DPL_id[5]));
-  strlcpy(DPL_id[6], doc["DPL_ID6"] | "D07", sizeof(DPL_id[6]));
-  strlcpy(DPL_id[7], doc["DPL_ID7"] | "D08", sizeof(DPL_id[7]));
-  strlcpy(DPL_station[0], doc["DPL_STATION00"] | "", sizeof(DPL_station[0]));
-  strlcpy(DPL_station[1], doc["DPL_STATION01"] | "", sizeof(DPL_station[1]));
-  strlcpy(DPL_station[2], doc["DPL_STATION02"] | "", sizeof(DPL_station[2]));
-  strlcpy(DPL_station[3], doc["DPL_STATION03"] | "", sizeof(DPL_station[3]));
-  strlcpy(DPL_station[4], doc["DPL_STATION04"] | "", sizeof(DPL_station[4]));
-  strlcpy(DPL_station[5], doc["DPL_STATION05"] | "", sizeof(DPL_station[5]));
-  strlcpy(DPL_station[6], doc["DPL_STATION06"] | "", sizeof(DPL_station[6]));
-  strlcpy(DPL_station[7], doc["DPL_STATION07"] | "", sizeof(DPL_station[7]));
-  strlcpy(DPL_track[0], doc["DPL_TRACK0"] | "1", sizeof(DPL_track[0]));
-  strlcpy(DPL_track[1], doc["DPL_TRACK1"] | "1", sizeof(DPL_track[1]));
-  strlcpy(DPL_track[2], doc["DPL_TRACK2"] | "1", sizeof(DPL_track[2]));
-  strlcpy(DPL_track[3], doc["DPL_TRACK3"] | "1", sizeof(DPL_track[3]));
-  strlcpy(DPL_track[4], doc["DPL_TRACK4"] | "1", sizeof(DPL_track[4]));
-  strlcpy(DPL_track[5], doc["DPL_TRACK5"] | "1", sizeof(DPL_track[5]));
-  strlcpy(DPL_track[6], doc["DPL_TRACK6"] | "1", sizeof(DPL_track[6]));
-  strlcpy(DPL_track[7], doc["DPL_TRACK7"] | "1", sizeof(DPL_track[7]));
-  DPL_flip[0] = doc["DPL_FLIP0"] | 0;
-  DPL_flip[1] = doc["DPL_FLIP1"] | 0;
-  DPL_flip[2] = doc["DPL_FLIP2"] | 0;
-  DPL_flip[3] = doc["DPL_FLIP3"] | 0;
-  DPL_flip[4] = doc["DPL_FLIP4"] | 0;
-  DPL_flip[5] = doc["DPL_FLIP5"] | 0;
-  DPL_flip[6] = doc["DPL_FLIP6"] | 0;
-  DPL_flip[7] = doc["DPL_FLIP7"] | 0;
-  DPL_contrast[0] = doc["DPL_CONTRAST0"] | 50;
-  DPL_contrast[1] = doc["DPL_CONTRAST1"] | 50;
-  DPL_contrast[2] = doc["DPL_CONTRAST2"] | 50;
-  DPL_contrast[3] = doc["DPL_CONTRAST3"] | 50;
-  DPL_contrast[4] = doc["DPL_CONTRAST4"] | 50;
-  DPL_contrast[5] = doc["DPL_CONTRAST5"] | 50;
-  DPL_contrast[6] = doc["DPL_CONTRAST6"] | 50;
-  DPL_contrast[7] = doc["DPL_CONTRAST7"] | 50;
-  DPL_side[0] = doc["DPL_SIDE0"] | 0;
-  DPL_side[1] = doc["DPL_SIDE1"] | 0;
-  DPL_side[2] = doc["DPL_SIDE2"] | 0;
-  DPL_side[3] = doc["DPL_SIDE3"] | 0;
-  DPL_side[4] = doc["DPL_SIDE4"] | 0;
-  DPL_side[5] = doc["DPL_SIDE5"] | 0;
-  DPL_side[6] = doc["DPL_SIDE6"] | 0;
-  DPL_side[7] = doc["DPL_SIDE7"] | 0;
+  char key[20];
+  char def[4];
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    snprintf(def, sizeof(def), "D%02u", i + 1);
+    strlcpy(DPL_id[i], doc[dplKey(key, sizeof(key), "ID", i)] | def, sizeof(DPL_id[i]));
+    strlcpy(DPL_station[i], doc[dplKey(key, sizeof(key), "STATION", i)] | "", sizeof(DPL_station[i]));
+    strlcpy(DPL_track[i], doc[dplKey(key, sizeof(key), "TRACK", i)] | "1", sizeof(DPL_track[i]));
+    DPL_flip[i] = doc[dplKey(key, sizeof(key), "FLIP", i)] | 0;
+    DPL_contrast[i] = doc[dplKey(key, sizeof(key), "CONTRAST", i)] | 50;
+    DPL_side[i] = doc[dplKey(key, sizeof(key), "SIDE", i)] | 0;
+  }
 
   file.close();
 }
@@ -187,6 +175,7 @@ void saveConfiguration(const char *configfile, const Config &config)
 {
   // Delete existing file, otherwise the configuration will be appended to the file
   LittleFS.remove(configfile);
+  LittleFS.remove(snapfile);
 
   // Open file for writing
   File file = LittleFS.open(configfile, "w");
@@ -211,62 +200,26 @@ void saveConfiguration(const char *configfile, const Config &config)
   doc["MQTT_TOPIC1"] = config.MQTT_TOPIC1;
   doc["MQTT_TOPIC2"] = config.MQTT_TOPIC2;
   doc["MQTT_DELIMITER"] = config.MQTT_DELIMITER;
+  doc["MQTT_ROUTE"] = config.MQTT_ROUTE;
   doc["MQTT_DEBUG"] = config.MQTT_DEBUG;
   doc["MUX"] = config.MUX;
   doc["NUMDISP"] = config.NUMDISP;
   doc["DISPWIDTH"] = config.DISPWIDTH;
   doc["DISPHEIGHT"] = config.DISPHEIGHT;
   doc["STARTDELAY"] = config.STARTDELAY;
+  doc["FASTBOOT"] = config.FASTBOOT;
   doc["UPDSPEED"] = config.UPDSPEED;
   doc["SCREENSAVER"] = config.SCREENSAVER;
-  doc["DPL_ID0"] = DPL_id[0];
-  doc["DPL_ID1"] = DPL_id[1];
-  doc["DPL_ID2"] = DPL_id[2];
-  doc["DPL_ID3"] = DPL_id[3];
-  doc["DPL_ID4"] = DPL_id[4];
-  doc["DPL_ID5"] = DPL_id[5];
-  doc["DPL_ID6"] = DPL_id[6];
-  doc["DPL_ID7"] = DPL_id[7];
-  doc["DPL_STATION00"] = DPL_station[0];
-  doc["DPL_STATION01"] = DPL_station[1];
-  doc["DPL_STATION02"] = DPL_station[2];
-  doc["DPL_STATION03"] = DPL_station[3];
-  doc["DPL_STATION04"] = DPL_station[4];
-  doc["DPL_STATION05"] = DPL_station[5];
-  doc["DPL_STATION06"] = DPL_station[6];
-  doc["DPL_STATION07"] = DPL_station[7];
-  doc["DPL_TRACK0"] = DPL_track[0];
-  doc["DPL_TRACK1"] = DPL_track[1];
-  doc["DPL_TRACK2"] = DPL_track[2];
-  doc["DPL_TRACK3"] = DPL_track[3];
-  doc["DPL_TRACK4"] = DPL_track[4];
-  doc["DPL_TRACK5"] = DPL_track[5];
-  doc["DPL_TRACK6"] = DPL_track[6];
-  doc["DPL_TRACK7"] = DPL_track[7];
-  doc["DPL_FLIP0"] = DPL_flip[0];
-  doc["DPL_FLIP1"] = DPL_flip[1];
-  doc["DPL_FLIP2"] = DPL_flip[2];
-  doc["DPL_FLIP3"] = DPL_flip[3];
-  doc["DPL_FLIP4"] = DPL_flip[4];
-  doc["DPL_FLIP5"] = DPL_flip[5];
-  doc["DPL_FLIP6"] = DPL_flip[6];
-  doc["DPL_FLIP7"] = DPL_flip[7];
-  doc["DPL_CONTRAST0"] = DPL_contrast[0];
-  doc["DPL_CONTRAST1"] = DPL_contrast[1];
-  doc["DPL_CONTRAST2"] = DPL_contrast[2];
-  doc["DPL_CONTRAST3"] = DPL_contrast[3];
-  doc["DPL_CONTRAST4"] = DPL_contrast[4];
-  doc["DPL_CONTRAST5"] = DPL_contrast[5];
-  doc["DPL_CONTRAST6"] = DPL_contrast[6];
-  doc["DPL_CONTRAST7"] = DPL_contrast[7];
-  doc["DPL_SIDE0"] = DPL_side[0];
-  doc["DPL_SIDE1"] = DPL_side[1];
-  doc["DPL_SIDE2"] = DPL_side[2];
-  doc["DPL_SIDE3"] = DPL_side[3];
-  doc["DPL_SIDE4"] = DPL_side[4];
-  doc["DPL_SIDE5"] = DPL_side[5];
-  doc["DPL_SIDE6"] = DPL_side[6];
-  doc["DPL_SIDE7"] = DPL_side[7];
+  doc["LOGORAM"] = config.LOGORAM;
+  char key[20];
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    doc[dplKey(key, sizeof(key), "ID", i)] = DPL_id[i];
+    doc[dplKey(key, sizeof(key), "STATION", i)] = DPL_station[i];
+    doc[dplKey(key, sizeof(key), "TRACK", i)] = DPL_track[i];
+    doc[dplKey(key, sizeof(key), "FLIP", i)] = DPL_flip[i];
+    doc[dplKey(key, sizeof(key), "CONTRAST", i)] = DPL_contrast[i];
+    doc[dplKey(key, sizeof(key), "SIDE", i)] = DPL_side[i];
+  }
 
   // Serialize JSON to file
   if (serializeJson(doc, file) == 0) {
@@ -363,6 +316,7 @@ void saveTemplate(const char *templatefile)
 {
   // Delete existing file, otherwise the template data will be appended to the file
   LittleFS.remove(templatefile);
+  LittleFS.remove(snapfile);
 
   // Open file for writing
   File file = LittleFS.open(templatefile, "w");
@@ -616,6 +570,7 @@ void saveTemplateFile(const char *templatexx)
 {
   // Delete existing file, otherwise the template data will be appended to the file
   LittleFS.remove(templatexx);
+  LittleFS.remove(snapfile);
 
   // Open file for writing
   File file = LittleFS.open(templatexx, "w");
@@ -748,6 +703,180 @@ void saveSec(const char *secfile, const Sec &sec)
 }
 
 
+// Binary snapshot of the configuration, templates and logo settings, loaded with one read at boot instead of parsing 12 json files.
+// The json files stay the editable form, the web pages write a new snapshot when they save them. Saving a json file
+// deletes the snapshot, so it is never older than the files, and a boot without snapshot writes a new one.
+// A snapshot is only valid for the firmware build that wrote it, the regions are copied as they are in memory.
+#define SNAPVERSION 3
+struct SnapHeader {
+  char     magic[4];                 // "RMDS"
+  uint16_t version;                  // SNAPVERSION
+  uint16_t regions;                  // number of regions
+  uint32_t size;                     // bytes after the header
+  uint32_t crc;                      // CRC-32 of the bytes after the header
+  char     build[24];                // __DATE__ " " __TIME__ of the firmware
+};
+struct SnapRegion {
+  void    *ptr;
+  uint16_t size;
+};
+#define SNAP(x) { (void *)(x), sizeof(x) }
+const SnapRegion snapRegions[] = {
+  { &config, sizeof(config) },
+  SNAP(DPL_id), SNAP(DPL_station), SNAP(DPL_track), SNAP(DPL_flip), SNAP(DPL_contrast), SNAP(DPL_side),
+  SNAP(TPL_id), SNAP(TPL_name), SNAP(TPL_side), SNAP(TPL_invert), SNAP(TPL_0font), SNAP(TPL_0maxwidth),
+  SNAP(TPL_0font2), SNAP(TPL_0drawcolor), SNAP(TPL_0fontmode), SNAP(TPL_0posx), SNAP(TPL_0posy), SNAP(TPL_0scroll),
+  SNAP(TPL_1font), SNAP(TPL_1drawcolor), SNAP(TPL_1fontmode), SNAP(TPL_1posx), SNAP(TPL_1posy), SNAP(TPL_2font),
+  SNAP(TPL_2maxwidth), SNAP(TPL_2font2), SNAP(TPL_2drawcolor), SNAP(TPL_2fontmode), SNAP(TPL_2posx), SNAP(TPL_2posy),
+  SNAP(TPL_2scroll), SNAP(TPL_3font), SNAP(TPL_3drawcolor), SNAP(TPL_3fontmode), SNAP(TPL_3posx), SNAP(TPL_3posy),
+  SNAP(TPL_4font), SNAP(TPL_4drawcolor), SNAP(TPL_4fontmode), SNAP(TPL_4posx), SNAP(TPL_4posy), SNAP(TPL_5logox),
+  SNAP(TPL_5logoy), SNAP(TPL_6font), SNAP(TPL_6maxwidth), SNAP(TPL_6font2), SNAP(TPL_6drawcolor), SNAP(TPL_6fontmode),
+  SNAP(TPL_6posx), SNAP(TPL_6posy), SNAP(TPL_6scroll), SNAP(TPL_6boxx), SNAP(TPL_6boxy), SNAP(TPL_6boxw),
+  SNAP(TPL_6boxh), SNAP(TPL_6drawcolor2), SNAP(TPL_6fontmode2), SNAP(TPL_6box2x), SNAP(TPL_6box2y), SNAP(TPL_6box2w),
+  SNAP(TPL_6box2h),
+  SNAP(logoId), SNAP(logow), SNAP(logoh)
+};
+#define SNAPREGIONS (sizeof(snapRegions) / sizeof(snapRegions[0]))
+
+
+// CRC-32 (IEEE 802.3) of len bytes, crc = result of the previous part or 0. Also identifies rendered frames, see frameCrc().
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+  crc = ~crc;
+  while (len--){
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++){
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+
+// Header of a snapshot of the current configuration and templates
+void snapHeader(SnapHeader &h)
+{
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "RMDS", 4);
+  h.version = SNAPVERSION;
+  h.regions = SNAPREGIONS;
+  for (uint8_t k = 0; k < SNAPREGIONS; k++){
+    h.size += snapRegions[k].size;
+  }
+  strlcpy(h.build, __DATE__ " " __TIME__, sizeof(h.build));
+}
+
+
+// Load configuration and templates from the snapshot, returns false if it is missing, outdated or damaged
+bool loadSnapshot()
+{
+  File file = LittleFS.open(snapfile, "r");
+  if (!file) {
+    return false;
+  }
+  SnapHeader want, h;
+  snapHeader(want);
+  bool ok = (file.read((uint8_t *)&h, sizeof(h)) == sizeof(h) && memcmp(h.magic, want.magic, 4) == 0 && h.version == want.version
+             && h.regions == want.regions && h.size == want.size && strcmp(h.build, want.build) == 0);
+  uint8_t *buf = ok ? (uint8_t *)malloc(h.size) : nullptr;
+  ok = (buf != nullptr && file.read(buf, h.size) == h.size && crc32(0, buf, h.size) == h.crc);
+  file.close();
+  if (ok) {
+    const uint8_t *p = buf;
+    for (uint8_t k = 0; k < SNAPREGIONS; k++){
+      memcpy(snapRegions[k].ptr, p, snapRegions[k].size);
+      p += snapRegions[k].size;
+    }
+  }
+  else {
+    Serial.println(F("Snapshot outdated or damaged, loading json files"));
+  }
+  free(buf);
+  return ok;
+}
+
+
+// Save configuration and templates to the snapshot, the runtime switches DEMO and PRINTBUF off as in the json file
+void saveSnapshot()
+{
+  Config saved = config;
+  saved.DEMO = 0;
+  saved.PRINTBUF = 0;
+  const void *data[SNAPREGIONS];
+  for (uint8_t k = 0; k < SNAPREGIONS; k++){
+    data[k] = (snapRegions[k].ptr == &config) ? &saved : snapRegions[k].ptr;
+  }
+  SnapHeader h;
+  snapHeader(h);
+  for (uint8_t k = 0; k < SNAPREGIONS; k++){
+    h.crc = crc32(h.crc, (const uint8_t *)data[k], snapRegions[k].size);
+  }
+  LittleFS.remove(snapfile);
+  File file = LittleFS.open(snapfile, "w");
+  if (!file) {
+    Serial.println(F("Failed to create snapshot file"));
+    return;
+  }
+  file.write((const uint8_t *)&h, sizeof(h));
+  for (uint8_t k = 0; k < SNAPREGIONS; k++){
+    file.write((const uint8_t *)data[k], snapRegions[k].size);
+  }
+  file.close();
+}
+
+
+// Build the logo table from the logos of template.h and the logo files in logodir within the RAM budget config.LOGORAM
+void loadLogos()
+{
+  logoClear();
+  for (uint8_t k = 0; k < 20; k++){
+    logoAdd(logoId[k], logow[k], logoh[k], (const uint8_t *)pgm_read_ptr(&logoBits[k]), false);
+  }
+  File dir = LittleFS.open(logodir, "r");
+  if (!dir || !dir.isDirectory()){
+    return;
+  }
+  for (File file = dir.openNextFile(); file; file = dir.openNextFile()){
+    // TrainType = file name without path and extension
+    char id[LOGOIDLEN];
+    const char *name = strrchr(file.name(), '/');
+    name = (name != nullptr) ? name + 1 : file.name();
+    const char *ext = strrchr(name, '.');
+    size_t len = (ext != nullptr) ? (size_t)(ext - name) : strlen(name);
+    if (file.isDirectory() || len == 0 || len >= sizeof(id) || file.size() > 16384){
+      Serial.printf("Logo %s skipped, name or size not supported\n", name);
+      file.close();
+      continue;
+    }
+    memcpy(id, name, len);
+    id[len] = '\0';
+    size_t size = file.size();
+    char *buf = (char *)malloc(size + 1);
+    uint8_t *bits = nullptr;
+    uint8_t w = 0, h = 0;
+    if (buf != nullptr){
+      buf[file.read((uint8_t *)buf, size)] = '\0';
+      size_t bytes = logoParse(buf, size, w, h, nullptr);
+      if (bytes == 0){
+        Serial.printf("Logo %s skipped, no XBM or PBM file\n", name);
+      }
+      else if (logoRam + bytes > config.LOGORAM){
+        Serial.printf("Logo %s skipped, %u bytes exceed the logo RAM budget of %u bytes\n", name, (unsigned)bytes, config.LOGORAM);
+      }
+      else if ((bits = (uint8_t *)malloc(bytes)) != nullptr && logoParse(buf, size, w, h, bits) == bytes){
+        logoAdd(id, w, h, bits, true);
+        bits = nullptr;
+      }
+      free(buf);
+    }
+    free(bits);
+    file.close();
+  }
+  dir.close();
+  Serial.printf("Logos: %u, %lu of %u bytes RAM used by logo files\n", logoCount, (unsigned long)logoRam, config.LOGORAM);
+}
+
+
 // Prints the content of a file to Serial
 void printFile(const char *pfile)
 {
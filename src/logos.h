@@ -0,0 +1,246 @@
+// Roc-MQTT-Display LOGO REGISTRY
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef LOGOS_H
+#define LOGOS_H
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Logos by TrainType, the built-in logos of template.h and the logos loaded from LittleFS in one hashed table.
+// A logo is found by its handle, the TrainType of a message is resolved to a handle once when it arrives.
+#define LOGOIDLEN   8              // TrainType incl. terminating 0, same as ZZA_TYPELEN
+#define LOGOBUCKETS 32             // hash buckets, power of 2
+#define LOGO_NONE   0              // handle of a TrainType without logo
+struct Logo {
+  char     id[LOGOIDLEN];          // TrainType, e.g. ICE
+  uint8_t  w;                      // width in pixel
+  uint8_t  h;                      // height in pixel
+  const uint8_t *bits;             // XBM bitmap, rows padded to full bytes, LSB = left pixel
+  bool     owned;                  // bits were allocated when loading the logo file
+  uint16_t next;                   // handle of the next logo in the same bucket
+};
+Logo    *logoTable = nullptr;      // logo with handle n at logoTable[n - 1]
+uint16_t logoCount = 0;
+uint16_t logoCap = 0;
+uint16_t logoBucket[LOGOBUCKETS];  // first handle of every bucket
+uint32_t logoRam = 0;              // bytes of the bitmaps loaded from files
+
+
+// Bytes of a w x h bitmap
+inline size_t logoBytes(uint8_t w, uint8_t h)
+{
+  return (size_t)((w + 7) / 8) * h;
+}
+
+
+// FNV-1a hash of a TrainType
+inline uint32_t logoHash(const char *id)
+{
+  uint32_t hash = 2166136261u;
+  for (; *id != '\0'; id++){
+    hash = (hash ^ (uint8_t)*id) * 16777619u;
+  }
+  return hash;
+}
+
+
+// Handle of the logo of TrainType id, LOGO_NONE if there is none
+inline uint16_t logoFind(const char *id)
+{
+  if (id[0] == '\0'){
+    return LOGO_NONE;
+  }
+  for (uint16_t n = logoBucket[logoHash(id) & (LOGOBUCKETS - 1)]; n != LOGO_NONE; n = logoTable[n - 1].next){
+    if (strcmp(logoTable[n - 1].id, id) == 0){
+      return n;
+    }
+  }
+  return LOGO_NONE;
+}
+
+
+// Logo of a valid handle
+inline const Logo &logoGet(uint16_t n)
+{
+  return logoTable[n - 1];
+}
+
+
+// Remove all logos and free the bitmaps loaded from files
+inline void logoClear()
+{
+  for (uint16_t k = 0; k < logoCount; k++){
+    if (logoTable[k].owned){
+      free((void *)logoTable[k].bits);
+    }
+  }
+  logoCount = 0;
+  logoRam = 0;
+  memset(logoBucket, 0, sizeof(logoBucket));
+}
+
+
+// Add the logo of TrainType id or replace the logo it has already, owned bits are freed with the logo.
+// Returns false if id is empty or longer than LOGOIDLEN - 1, or the table can't grow.
+inline bool logoAdd(const char *id, uint8_t w, uint8_t h, const uint8_t *bits, bool owned)
+{
+  if (id[0] == '\0' || strlen(id) >= LOGOIDLEN){
+    return false;
+  }
+  uint16_t n = logoFind(id);
+  if (n == LOGO_NONE){
+    if (logoCount == logoCap){
+      uint16_t cap = (logoCap == 0) ? 32 : logoCap * 2;
+      Logo *table = (Logo *)realloc(logoTable, cap * sizeof(Logo));
+      if (table == nullptr){
+        return false;
+      }
+      logoTable = table;
+      logoCap = cap;
+    }
+    n = ++logoCount;
+    Logo &l = logoTable[n - 1];
+    strlcpy(l.id, id, sizeof(l.id));
+    uint16_t &bucket = logoBucket[logoHash(l.id) & (LOGOBUCKETS - 1)];
+    l.next = bucket;
+    l.owned = false;
+    bucket = n;
+  }
+  Logo &l = logoTable[n - 1];
+  if (l.owned){
+    free((void *)l.bits);
+    logoRam -= logoBytes(l.w, l.h);
+  }
+  l.w = w;
+  l.h = h;
+  l.bits = bits;
+  l.owned = owned;
+  if (owned){
+    logoRam += logoBytes(w, h);
+  }
+  return true;
+}
+
+
+// Skip blanks and PBM comments
+inline const char *logoSkip(const char *s, const char *end)
+{
+  while (s < end){
+    if (*s == '#'){
+      while (s < end && *s != '\n'){
+        s++;
+      }
+    }
+    else if (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n'){
+      s++;
+    }
+    else {
+      break;
+    }
+  }
+  return s;
+}
+
+
+// Read a decimal number, returns -1 if there is none
+inline long logoNumber(const char *&s, const char *end)
+{
+  long n = -1;
+  while (s < end && *s >= '0' && *s <= '9'){
+    n = (n < 0 ? 0 : n * 10) + (*s - '0');
+    s++;
+  }
+  return n;
+}
+
+
+// Read width and height of a logo file, XBM or PBM (P1 text, P4 binary), and the bitmap if out isn't nullptr.
+// Text files must be followed by a terminating 0. Returns the size of the bitmap in bytes, 0 if the file is no valid logo.
+inline size_t logoParse(const char *s, size_t len, uint8_t &w, uint8_t &h, uint8_t *out)
+{
+  const char *end = s + len;
+  long lw = -1, lh = -1;
+  char format = 'X';
+  const char *p = s;
+  if (end - p >= 2 && p[0] == 'P' && (p[1] == '1' || p[1] == '4')){
+    // PBM: P1/P4 width height, then the pixel rows, 1 = black = pixel on
+    format = p[1];
+    p = logoSkip(p + 2, end);
+    lw = logoNumber(p, end);
+    p = logoSkip(p, end);
+    lh = logoNumber(p, end);
+    if (format == '4'){
+      p++;                         // single blank before the binary rows
+    }
+  }
+  else {
+    // XBM: #define name_width 17, #define name_height 11, static unsigned char name_bits[] = { 0x.., ... };
+    for (; p < end && (lw < 0 || lh < 0); p++){
+      if (end - p > 7 && memcmp(p, "_width ", 7) == 0){
+        p = logoSkip(p + 7, end);
+        lw = logoNumber(p, end);
+      }
+      else if (end - p > 8 && memcmp(p, "_height ", 8) == 0){
+        p = logoSkip(p + 8, end);
+        lh = logoNumber(p, end);
+      }
+    }
+    while (p < end && *p != '{'){
+      p++;
+    }
+  }
+  if (lw < 1 || lw > 255 || lh < 1 || lh > 255 || p >= end){
+    return 0;
+  }
+  w = lw;
+  h = lh;
+  size_t size = logoBytes(w, h);
+  if (out == nullptr){
+    return size;
+  }
+  uint8_t rowBytes = (w + 7) / 8;
+  if (format == '4'){
+    // Rows MSB first, XBM is LSB first
+    if ((size_t)(end - p) < size){
+      return 0;
+    }
+    for (size_t k = 0; k < size; k++){
+      uint8_t b = p[k];
+      b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+      b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+      out[k] = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+    }
+    return size;
+  }
+  memset(out, 0, size);
+  if (format == '1'){
+    for (uint16_t k = 0; k < (uint16_t)w * h; k++){
+      p = logoSkip(p, end);
+      if (p >= end || (*p != '0' && *p != '1')){
+        return 0;
+      }
+      if (*p++ == '1'){
+        out[(k / w) * rowBytes + (k % w) / 8] |= 1 << (k % w % 8);
+      }
+    }
+    return size;
+  }
+  for (size_t k = 0; k < size; k++){
+    while (p < end && !(p[0] == '0' && p + 1 < end && (p[1] == 'x' || p[1] == 'X'))){
+      if (*p == '}'){
+        return 0;
+      }
+      p++;
+    }
+    if (p >= end){
+      return 0;
+    }
+    out[k] = (uint8_t)strtoul(p, (char **)&p, 16);
+  }
+  return size;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Roc-MQTT-Display METRICS
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef METRICS_H
+#define METRICS_H
+#include <stdint.h>
+#include <stdio.h>
+
+// Execution time statistics of a task or callback.
+// With RENDERTASK the statistics of the display task are written on the other core, read them as a copy taken under StateLock.
+// Bin k of the histogram counts run times from 2^k to 2^(k+1)-1 microseconds, the last bin everything above.
+#define TIMEBINS 20
+struct TaskTiming {
+  uint32_t count;                  // number of runs
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint32_t bins[TIMEBINS];
+  uint32_t overruns;               // runs that started after their next scheduled start
+  uint32_t maxDelayMs;             // largest delay between scheduled and actual start
+};
+
+
+// Add one run of us microseconds
+inline void timingAdd(TaskTiming &m, uint32_t us)
+{
+  if (m.count == 0 || us < m.minUs){
+    m.minUs = us;
+  }
+  if (us > m.maxUs){
+    m.maxUs = us;
+  }
+  m.count++;
+  m.sumUs += us;
+  uint8_t k = 0;
+  while (k < TIMEBINS - 1 && (us >> (k + 1)) != 0){
+    k++;
+  }
+  m.bins[k]++;
+}
+
+
+// Add the scheduling of a task run, overrun < 0 means the run started late, delay in milliseconds
+inline void timingSchedule(TaskTiming &m, long overrun, uint32_t delayMs)
+{
+  if (overrun < 0){
+    m.overruns++;
+  }
+  if (delayMs > m.maxDelayMs){
+    m.maxDelayMs = delayMs;
+  }
+}
+
+
+// Average run time in microseconds
+inline uint32_t timingAvg(const TaskTiming &m)
+{
+  return (m.count > 0) ? (uint32_t)(m.sumUs / m.count) : 0;
+}
+
+
+// 99th percentile of the run time, upper bound of the histogram bin, limited to the maximum
+inline uint32_t timingP99(const TaskTiming &m)
+{
+  uint32_t limit = m.count - m.count / 100;
+  uint32_t n = 0;
+  for (uint8_t k = 0; k < TIMEBINS; k++){
+    n += m.bins[k];
+    if (n >= limit && n > 0){
+      uint32_t upper = (k < TIMEBINS - 1) ? ((uint32_t)2 << k) - 1 : m.maxUs;
+      return (upper < m.maxUs) ? upper : m.maxUs;
+    }
+  }
+  return 0;
+}
+
+
+// Boot timeline, the phases of the start in the order they ended
+#define BOOTPHASES 12
+struct BootPhase {
+  const char *name;
+  uint32_t    us;                  // end of the phase, microseconds after reset
+};
+BootPhase bootPhase[BOOTPHASES];
+uint8_t   bootPhaseCount = 0;
+
+
+// End of the boot phase name at us microseconds after reset
+inline void bootMark(const char *name, uint32_t us)
+{
+  if (bootPhaseCount < BOOTPHASES){
+    bootPhase[bootPhaseCount++] = { name, us };
+  }
+}
+
+
+// Boot timeline as text, e.g. "serial 0.61 s, config 0.65 s", returns the length
+inline size_t bootFormat(char *out, size_t size)
+{
+  size_t n = 0;
+  out[0] = '\0';
+  for (uint8_t k = 0; k < bootPhaseCount && n < size; k++){
+    n += snprintf(out + n, size - n, "%s%s %lu.%02lu s", k > 0 ? ", " : "", bootPhase[k].name,
+                  (unsigned long)(bootPhase[k].us / 1000000), (unsigned long)(bootPhase[k].us / 10000 % 100));
+  }
+  return (n < size) ? n : size - 1;
+}
+
+#endif
@@ -0,0 +1,79 @@
+// Roc-MQTT-Display RAILROAD CLOCK PARSER
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef RRCLOCK_H
+#define RRCLOCK_H
+#include <stdint.h>
+#include <string.h>
+
+// Rocrail clock, e.g.
+// <clock divider="1" hour="18" minute="40" wday="5" mday="12" month="2" year="2021" time="1613151626" temp="20" bri="255" lux="0" pressure="0" humidity="0" cmd="sync"/>
+struct RRClock {
+  int16_t hour;        // -1 = attribute not found or out of range
+  int16_t minute;
+  int16_t wday;        // 1 = Monday ... 7 = Sunday
+  int16_t mday;
+  int16_t month;
+  int16_t year;
+};
+
+
+// Numeric value of an attribute, -1 if it contains no digits or is larger than max
+inline int16_t rrClockNumber(const char *s, const char *end, int16_t max)
+{
+  int32_t n = -1;
+  while (s < end && *s >= '0' && *s <= '9'){
+    n = (n < 0 ? 0 : n * 10) + (*s - '0');
+    if (n > max){
+      return -1;
+    }
+    s++;
+  }
+  return (int16_t)n;
+}
+
+
+// Read the clock attributes from len bytes of s in one pass, the order of the attributes doesn't matter.
+// Values above the range of the attribute count as not found. Returns true if hour and minute were found.
+inline bool rrClockParse(const char *s, size_t len, RRClock &c)
+{
+  static const char *names[6] = { "hour", "minute", "wday", "mday", "month", "year" };
+  static const int16_t maxs[6] = { 23, 59, 7, 31, 12, 9999 };
+  int16_t *values[6] = { &c.hour, &c.minute, &c.wday, &c.mday, &c.month, &c.year };
+  for (uint8_t k = 0; k < 6; k++){
+    *values[k] = -1;
+  }
+  const char *end = s + len;
+  const char *name = s;
+  for (const char *p = s; p + 1 < end; p++){
+    char ch = *p;
+    if (ch == '=' && p[1] == '"'){
+      // Attribute name="value", the name starts after the last blank
+      const char *v = p + 2;
+      const char *q = v;
+      while (q < end && *q != '"'){
+        q++;
+      }
+      for (uint8_t k = 0; k < 6; k++){
+        size_t l = strlen(names[k]);
+        if ((size_t)(p - name) == l && memcmp(name, names[k], l) == 0){
+          *values[k] = rrClockNumber(v, q, maxs[k]);
+          break;
+        }
+      }
+      if (q >= end){
+        break;
+      }
+      p = q;
+      name = q + 1;
+    }
+    else if (ch == ' ' || ch == '<' || ch == '\t' || ch == '\n' || ch == '\r'){
+      name = p + 1;
+    }
+  }
+  return c.hour >= 0 && c.minute >= 0;
+}
+
+#endif
@@ -86,7 +86,7 @@ int TPL_6box2h[] =           {  10,  10,   0,   0,   0,   0,   0,   0,   0,   0
 
 // FONTS & LOGOS
 // FONTS 0 - 9
-char fonts[10][40] = { "u8g2_font_7x13_tf", "u8g2_font_crox3hb_tf", "u8g2_font_9x15_tf", "u8g2_font_rosencrantz_nbp_tf", "u8g2_font_helvR08_tf", "u8g2_font_5x7_tf", "u8g2_font_6x10_tf", "u8g2_font_crox4hb_tf", "u8g2_font_crox1hb_tf", "u8g2_font_fur17_tf" };
+const char fonts[10][40] PROGMEM = { "u8g2_font_7x13_tf", "u8g2_font_crox3hb_tf", "u8g2_font_9x15_tf", "u8g2_font_rosencrantz_nbp_tf", "u8g2_font_helvR08_tf", "u8g2_font_5x7_tf", "u8g2_font_6x10_tf", "u8g2_font_crox4hb_tf", "u8g2_font_crox1hb_tf", "u8g2_font_fur17_tf" };
 
 const uint8_t *fontno[10] = { 
   u8g2_font_7x13_tf,                   // font0, start screen, 
@@ -101,123 +101,110 @@ const uint8_t *fontno[10] = {
   u8g2_font_fur17_tf                   // font9, station
   };
 
-// Logos in monochrome bitmap .xbm format
+// Logos in monochrome bitmap .xbm format, the bitmaps stay in flash (PROGMEM) and are drawn from there
 // LOGO 0 - 19:           0,     1,     2,     3,     4,     5,     6,     7,     8,     9,    10,    11,    12,    13,    14,    15,    16,    17,    18,    19
 char logoId[20][5] = { "DB", "ICE",  "IC",  "RE",  "RB",   "U",   "S",   "A", "SBB", "ÖBB",  "NS",    "",    "",    "",    "",    "",    "",    "",    "",    "" };  // logo id
 uint8_t logow[]    = {   17,    20,    11,    12,    12,    10,    12,    12,    15,    19,    20,    10,    10,    10,    10,    10,    10,    10,    10,    10 };  // logo width in pixel
 uint8_t logoh[]    = {   11,     9,     8,    10,    10,    10,    12,    12,    10,     8,     8,    10,    10,    10,    10,    10,    10,    10,    10,    10 };  // logo height in pixel
 
 //  Logo 0 - DB - Deutsche Bahn, Germany
-unsigned char logo0[] = { 0xfe, 0xff, 0x00, 0x01, 0x00, 0x01, 0x7d, 0x3e, 0x01, 0xcd, 0x66, 0x01,
-                          0xcd, 0x66, 0x01, 0xcd, 0x3e, 0x01, 0xcd, 0x66, 0x01, 0xcd, 0x66, 0x01,
-                          0x7d, 0x3e, 0x01, 0x01, 0x00, 0x01, 0xfe, 0xff, 0x00 };                                 
+const unsigned char logo0[] PROGMEM = { 0xfe, 0xff, 0x00, 0x01, 0x00, 0x01, 0x7d, 0x3e, 0x01, 0xcd, 0x66, 0x01,
+                                        0xcd, 0x66, 0x01, 0xcd, 0x3e, 0x01, 0xcd, 0x66, 0x01, 0xcd, 0x66, 0x01,
+                                        0x7d, 0x3e, 0x01, 0x01, 0x00, 0x01, 0xfe, 0xff, 0x00 };                                 
 const int logo0size = sizeof(logo0)/sizeof(logo0[0]);  // size of logo array
-unsigned char (*pl0)[logo0size] = &logo0;              // pointer to logo
 
 //  Logo 1 - ICE - Intercity-Express, Germany
-unsigned char logo1[] = { 0x18, 0xcf, 0x0f, 0xdc, 0xcf, 0x0f, 0xcc, 0x60, 0x00, 0xec, 0x60, 0x00,
-                          0x66, 0xe0, 0x03, 0x66, 0x30, 0x00, 0xe6, 0x30, 0x00, 0xe3, 0xf3, 0x03,
-                          0xc3, 0xf3, 0x03 };
+const unsigned char logo1[] PROGMEM = { 0x18, 0xcf, 0x0f, 0xdc, 0xcf, 0x0f, 0xcc, 0x60, 0x00, 0xec, 0x60, 0x00,
+                                        0x66, 0xe0, 0x03, 0x66, 0x30, 0x00, 0xe6, 0x30, 0x00, 0xe3, 0xf3, 0x03,
+                                        0xc3, 0xf3, 0x03 };
 const int logo1size = sizeof(logo1)/sizeof(logo1[0]);
-unsigned char (*pl1)[logo1size] = &logo1;
 
 //  Logo 2 - IC - Intercity, Germany
-unsigned char logo2[] = { 0x98, 0x07, 0xcc, 0x01, 0xec, 0x00, 0x66, 0x00, 0x66, 0x00, 0x66, 0x00,
-                          0xe3, 0x00, 0xc3, 0x01 };
+const unsigned char logo2[] PROGMEM = { 0x98, 0x07, 0xcc, 0x01, 0xec, 0x00, 0x66, 0x00, 0x66, 0x00, 0x66, 0x00,
+                                        0xe3, 0x00, 0xc3, 0x01 };
 const int logo2size = sizeof(logo2)/sizeof(logo2[0]);
-unsigned char (*pl2)[logo2size] = &logo2;
 
 //  Logo 3 - RE - Regional-Express, Germany
-unsigned char logo3[] = { 0xfe, 0x07, 0x03, 0x0c, 0xb9, 0x0b, 0xa9, 0x08, 0xbd, 0x09, 0x9d, 0x08,
-                          0xd5, 0x08, 0xd5, 0x09, 0x03, 0x0c, 0xfe, 0x07 };
+const unsigned char logo3[] PROGMEM = { 0xfe, 0x07, 0x03, 0x0c, 0xb9, 0x0b, 0xa9, 0x08, 0xbd, 0x09, 0x9d, 0x08,
+                                        0xd5, 0x08, 0xd5, 0x09, 0x03, 0x0c, 0xfe, 0x07 };
 const int logo3size = sizeof(logo3)/sizeof(logo3[0]);
-unsigned char (*pl3)[logo3size] = &logo3;
 
 //  Logo 4 - RB - Regionalbahn, Germany
-unsigned char logo4[] = { 0xfe, 0x07, 0x03, 0x0c, 0xb9, 0x0b, 0xa9, 0x0a, 0xbd, 0x0b, 0x9d, 0x0a,
-                          0xd5, 0x0a, 0xd5, 0x0b, 0x03, 0x0c, 0xfe, 0x07 };
+const unsigned char logo4[] PROGMEM = { 0xfe, 0x07, 0x03, 0x0c, 0xb9, 0x0b, 0xa9, 0x0a, 0xbd, 0x0b, 0x9d, 0x0a,
+                                        0xd5, 0x0a, 0xd5, 0x0b, 0x03, 0x0c, 0xfe, 0x07 };
 const int logo4size = sizeof(logo4)/sizeof(logo4[0]);
-unsigned char (*pl4)[logo4size] = &logo4;
 
 //  Logo 5 - U - U-Bahn, Germany
-unsigned char logo5[] = { 0xff, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03,
-                          0x33, 0x03, 0x33, 0x03, 0x87, 0x03, 0xff, 0x03 };
+const unsigned char logo5[] PROGMEM = { 0xff, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03,
+                                        0x33, 0x03, 0x33, 0x03, 0x87, 0x03, 0xff, 0x03 };
 const int logo5size = sizeof(logo5)/sizeof(logo5[0]);
-unsigned char (*pl5)[logo5size] = &logo5;
 
 //  Logo 6 - S - S-Bahn, Germany
-unsigned char logo6[] = { 0xf0, 0x00, 0x9c, 0x03, 0x06, 0x06, 0xe2, 0x04, 0xe3, 0x0f, 0x87, 0x0f,
-                          0x1f, 0x0e, 0x7f, 0x0c, 0xf3, 0x04, 0x62, 0x06, 0x0c, 0x07, 0xf8, 0x01 };
+const unsigned char logo6[] PROGMEM = { 0xf0, 0x00, 0x9c, 0x03, 0x06, 0x06, 0xe2, 0x04, 0xe3, 0x0f, 0x87, 0x0f,
+                                        0x1f, 0x0e, 0x7f, 0x0c, 0xf3, 0x04, 0x62, 0x06, 0x0c, 0x07, 0xf8, 0x01 };
 const int logo6size = sizeof(logo6)/sizeof(logo6[0]);
-unsigned char (*pl6)[logo6size] = &logo6;
 
 //  Logo 7 - AKN - Germany
-unsigned char logo7[] = { 0xf0, 0x00, 0x9c, 0x03, 0x0e, 0x07, 0x0e, 0x07, 0x67, 0x0e, 0xe7, 0x0e,
-                          0xf7, 0x0e, 0x03, 0x0c, 0xf3, 0x04, 0xfa, 0x05, 0xfe, 0x07, 0xf0, 0x01 };
+const unsigned char logo7[] PROGMEM = { 0xf0, 0x00, 0x9c, 0x03, 0x0e, 0x07, 0x0e, 0x07, 0x67, 0x0e, 0xe7, 0x0e,
+                                        0xf7, 0x0e, 0x03, 0x0c, 0xf3, 0x04, 0xfa, 0x05, 0xfe, 0x07, 0xf0, 0x01 };
 const int logo7size = sizeof(logo7)/sizeof(logo7[0]);
-unsigned char (*pl7)[logo7size] = &logo7;
 
 //  Logo 8 - SBB - Schweizerische Bundesbahnen, Switzerland
-unsigned char logo8[] = { 0x00, 0x00, 0xb0, 0x06, 0x98, 0x0c, 0x8c, 0x18, 0xfe, 0x3f, 0xfe, 0x3f,
-                          0x8c, 0x18, 0x98, 0x0c, 0xb0, 0x06, 0x00, 0x00 };
+const unsigned char logo8[] PROGMEM = { 0x00, 0x00, 0xb0, 0x06, 0x98, 0x0c, 0x8c, 0x18, 0xfe, 0x3f, 0xfe, 0x3f,
+                                        0x8c, 0x18, 0x98, 0x0c, 0xb0, 0x06, 0x00, 0x00 };
 const int logo8size = sizeof(logo8)/sizeof(logo8[0]);
-unsigned char (*pl8)[logo8size] = &logo8;
 
 //  Logo 9 - ÖBB - Österreichischen Bundesbahnen, Austria
-unsigned char logo9[] = { 0x2c, 0xcf, 0x03, 0x36, 0x59, 0x06, 0x53, 0x59, 0x06, 0x41, 0xcf, 0x03,
-                          0x41, 0x59, 0x06, 0x63, 0x59, 0x06, 0x36, 0x59, 0x06, 0x1c, 0xcf, 0x03 };
+const unsigned char logo9[] PROGMEM = { 0x2c, 0xcf, 0x03, 0x36, 0x59, 0x06, 0x53, 0x59, 0x06, 0x41, 0xcf, 0x03,
+                                        0x41, 0x59, 0x06, 0x63, 0x59, 0x06, 0x36, 0x59, 0x06, 0x1c, 0xcf, 0x03 };
 const int logo9size = sizeof(logo9)/sizeof(logo9[0]);
-unsigned char (*pl9)[logo9size] = &logo9;
 
 //  Logo 10 - NS - Nederlandse Spoorwegen, The Netherlands
-unsigned char logo10[] = { 0xf8, 0xc3, 0x01, 0xfc, 0x87, 0x03, 0x0e, 0x0e, 0x07, 0xff, 0xf8, 0x07,
-                           0xfe, 0xf1, 0x0f, 0x0e, 0x07, 0x07, 0x1c, 0xfe, 0x03, 0x38, 0xfc, 0x01 };
+const unsigned char logo10[] PROGMEM = { 0xf8, 0xc3, 0x01, 0xfc, 0x87, 0x03, 0x0e, 0x0e, 0x07, 0xff, 0xf8, 0x07,
+                                         0xfe, 0xf1, 0x0f, 0x0e, 0x07, 0x07, 0x1c, 0xfe, 0x03, 0x38, 0xfc, 0x01 };
 const int logo10size = sizeof(logo10)/sizeof(logo10[0]);
-unsigned char (*pl10)[logo10size] = &logo10;
 
 //  Logo 11 - 
-unsigned char logo11[] = { 0x00 };
+const unsigned char logo11[] PROGMEM = { 0x00 };
 const int logo11size = sizeof(logo11)/sizeof(logo11[0]);
-unsigned char (*pl11)[logo11size] = &logo11;
 
 //  Logo 12 - 
-unsigned char logo12[] = { 0x00 };
+const unsigned char logo12[] PROGMEM = { 0x00 };
 const int logo12size = sizeof(logo12)/sizeof(logo12[0]);
-unsigned char (*pl12)[logo12size] = &logo12;
 
 //  Logo 13 - 
-unsigned char logo13[] = { 0x00 };
+const unsigned char logo13[] PROGMEM = { 0x00 };
 const int logo13size = sizeof(logo13)/sizeof(logo13[0]);
-unsigned char (*pl13)[logo13size] = &logo13;
 
 //  Logo 14 - 
-unsigned char logo14[] = { 0x00 };
+const unsigned char logo14[] PROGMEM = { 0x00 };
 const int logo14size = sizeof(logo14)/sizeof(logo14[0]);
-unsigned char (*pl14)[logo14size] = &logo14;
 
 //  Logo 15 - 
-unsigned char logo15[] = { 0x00 };
+const unsigned char logo15[] PROGMEM = { 0x00 };
 const int logo15size = sizeof(logo15)/sizeof(logo15[0]);
-unsigned char (*pl15)[logo15size] = &logo15;
 
 //  Logo 16 - 
-unsigned char logo16[] = { 0x00 };
+const unsigned char logo16[] PROGMEM = { 0x00 };
 const int logo16size = sizeof(logo16)/sizeof(logo16[0]);
-unsigned char (*pl16)[logo16size] = &logo16;
 
 //  Logo 17 - 
-unsigned char logo17[] = { 0x00 };
+const unsigned char logo17[] PROGMEM = { 0x00 };
 const int logo17size = sizeof(logo17)/sizeof(logo17[0]);
-unsigned char (*pl17)[logo17size] = &logo17;
 
 //  Logo 18 - 
-unsigned char logo18[] = { 0x00 };
+const unsigned char logo18[] PROGMEM = { 0x00 };
 const int logo18size = sizeof(logo18)/sizeof(logo18[0]);
-unsigned char (*pl18)[logo18size] = &logo18;
 
 //  Logo 19 - 
-unsigned char logo19[] = { 0x00 };
+const unsigned char logo19[] PROGMEM = { 0x00 };
 const int logo19size = sizeof(logo19)/sizeof(logo19[0]);
-unsigned char (*pl19)[logo19size] = &logo19;
+
+// Bitmaps of logo 0 - 19, registered with logoId[], logow[] and logoh[] in the logo table at boot
+const unsigned char *const logoBits[20] PROGMEM = { logo0, logo1, logo2, logo3, logo4, logo5, logo6, logo7, logo8, logo9,
+                                            logo10, logo11, logo12, logo13, logo14, logo15, logo16, logo17, logo18, logo19 };
+const size_t logoFlash = sizeof(logo0) + sizeof(logo1) + sizeof(logo2) + sizeof(logo3) + sizeof(logo4) + sizeof(logo5) + sizeof(logo6)
+                       + sizeof(logo7) + sizeof(logo8) + sizeof(logo9) + sizeof(logo10) + sizeof(logo11) + sizeof(logo12) + sizeof(logo13)
+                       + sizeof(logo14) + sizeof(logo15) + sizeof(logo16) + sizeof(logo17) + sizeof(logo18) + sizeof(logo19) + sizeof(logoBits);
 
 #endif
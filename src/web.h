@@ -8,6 +8,7 @@
 #include <FS.h>
 #include <LittleFS.h>            // LittleFS file system https://github.com/esp8266/Arduino/tree/master/libraries/LittleFS
 #include "config.h"              // Roc-MQTT-Display configuration file
+#include "metrics.h"             // Roc-MQTT-Display execution time statistics and boot timeline
 #if defined(ESP8266)             // ESP8266
 #include <ESP8266WebServer.h>    //
 ESP8266WebServer webserver(80);  //
@@ -51,6 +52,9 @@ void loadRoot()
   buf1.replace("%VER%", config.VER);
   buf1.replace("%WIFI_DEVICENAME%", String(config.WIFI_DEVICENAME));
   buf1.replace("%STAT%", handleStats());
+  char boot[256];
+  bootFormat(boot, sizeof(boot));
+  buf1.replace("%BOOT%", boot);
   webserver.setContentLength( buf1.length() );
   webserver.send( 200, "text/html", buf1 );
   buf1 = "";
@@ -84,6 +88,7 @@ void loadCfg()
   buf1.replace("%MQTT_TOPIC1%", String(config.MQTT_TOPIC1));
   buf1.replace("%MQTT_TOPIC2%", String(config.MQTT_TOPIC2));
   buf1.replace("%MQTT_DELIMITER%", String(config.MQTT_DELIMITER));
+  buf1.replace("%MQTT_ROUTE%", String(config.MQTT_ROUTE));
   buf1.replace("%MQTT_DEBUG%", String(config.MQTT_DEBUG));
   buf1.replace("%MUX%", String(config.MUX));
   if (config.MUX < 16){
@@ -97,57 +102,20 @@ void loadCfg()
   buf1.replace("%DISPHEIGHT%", String(config.DISPHEIGHT));
   buf1.replace("%DISPSIZE%", String(config.DISPWIDTH) + " x " + String(config.DISPHEIGHT));
   buf1.replace("%STARTDELAY%", String(config.STARTDELAY));
+  buf1.replace("%FASTBOOT%", String(config.FASTBOOT));
   buf1.replace("%UPDSPEED%", String(config.UPDSPEED));
   buf1.replace("%SCREENSAVER%", String(config.SCREENSAVER));
+  buf1.replace("%LOGORAM%", String(config.LOGORAM));
   buf1.replace("%PRINTBUF%", String(config.PRINTBUF));
-  buf1.replace("%DPL_ID0%", String(DPL_id[0]));
-  buf1.replace("%DPL_ID1%", String(DPL_id[1]));
-  buf1.replace("%DPL_ID2%", String(DPL_id[2]));
-  buf1.replace("%DPL_ID3%", String(DPL_id[3]));
-  buf1.replace("%DPL_ID4%", String(DPL_id[4]));
-  buf1.replace("%DPL_ID5%", String(DPL_id[5]));
-  buf1.replace("%DPL_ID6%", String(DPL_id[6]));
-  buf1.replace("%DPL_ID7%", String(DPL_id[7]));
-  buf1.replace("%DPL_STATION00%", String(DPL_station[0]));
-  buf1.replace("%DPL_STATION01%", String(DPL_station[1]));
-  buf1.replace("%DPL_STATION02%", String(DPL_station[2]));
-  buf1.replace("%DPL_STATION03%", String(DPL_station[3]));
-  buf1.replace("%DPL_STATION04%", String(DPL_station[4]));
-  buf1.replace("%DPL_STATION05%", String(DPL_station[5]));
-  buf1.replace("%DPL_STATION06%", String(DPL_station[6]));
-  buf1.replace("%DPL_STATION07%", String(DPL_station[7]));
-  buf1.replace("%DPL_TRACK0%", String(DPL_track[0]));
-  buf1.replace("%DPL_TRACK1%", String(DPL_track[1]));
-  buf1.replace("%DPL_TRACK2%", String(DPL_track[2]));
-  buf1.replace("%DPL_TRACK3%", String(DPL_track[3]));
-  buf1.replace("%DPL_TRACK4%", String(DPL_track[4]));
-  buf1.replace("%DPL_TRACK5%", String(DPL_track[5]));
-  buf1.replace("%DPL_TRACK6%", String(DPL_track[6]));
-  buf1.replace("%DPL_TRACK7%", String(DPL_track[7]));
-  buf1.replace("%DPL_FLIP0%", String(DPL_flip[0]));
-  buf1.replace("%DPL_FLIP1%", String(DPL_flip[1]));
-  buf1.replace("%DPL_FLIP2%", String(DPL_flip[2]));
-  buf1.replace("%DPL_FLIP3%", String(DPL_flip[3]));
-  buf1.replace("%DPL_FLIP4%", String(DPL_flip[4]));
-  buf1.replace("%DPL_FLIP5%", String(DPL_flip[5]));
-  buf1.replace("%DPL_FLIP6%", String(DPL_flip[6]));
-  buf1.replace("%DPL_FLIP7%", String(DPL_flip[7]));
-  buf1.replace("%DPL_CONTRAST0%", String(DPL_contrast[0]));
-  buf1.replace("%DPL_CONTRAST1%", String(DPL_contrast[1]));
-  buf1.replace("%DPL_CONTRAST2%", String(DPL_contrast[2]));
-  buf1.replace("%DPL_CONTRAST3%", String(DPL_contrast[3]));
-  buf1.replace("%DPL_CONTRAST4%", String(DPL_contrast[4]));
-  buf1.replace("%DPL_CONTRAST5%", String(DPL_contrast[5]));
-  buf1.replace("%DPL_CONTRAST6%", String(DPL_contrast[6]));
-  buf1.replace("%DPL_CONTRAST7%", String(DPL_contrast[7]));
-  buf1.replace("%DPL_SIDE0%", String(DPL_side[0]));
-  buf1.replace("%DPL_SIDE1%", String(DPL_side[1]));
-  buf1.replace("%DPL_SIDE2%", String(DPL_side[2]));
-  buf1.replace("%DPL_SIDE3%", String(DPL_side[3]));
-  buf1.replace("%DPL_SIDE4%", String(DPL_side[4]));
-  buf1.replace("%DPL_SIDE5%", String(DPL_side[5]));
-  buf1.replace("%DPL_SIDE6%", String(DPL_side[6]));
-  buf1.replace("%DPL_SIDE7%", String(DPL_side[7]));
+  char key[20];
+  for (uint8_t i = 0; i < MAXDISP; i++){
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "ID", i)) + "%", String(DPL_id[i]));
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "STATION", i)) + "%", String(DPL_station[i]));
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "TRACK", i)) + "%", String(DPL_track[i]));
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "FLIP", i)) + "%", String(DPL_flip[i]));
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "CONTRAST", i)) + "%", String(DPL_contrast[i]));
+    buf1.replace("%" + String(dplKey(key, sizeof(key), "SIDE", i)) + "%", String(DPL_side[i]));
+  }
   webserver.setContentLength( buf1.length() );
   webserver.send( 200, "text/html", buf1 );
   buf1 = "";
@@ -171,6 +139,7 @@ void handleCfgSubmit()
       if (webserver.argName(i) == "f_MQTT_TOPIC1") { webserver.arg(webserver.argName(i)).toCharArray(config.MQTT_TOPIC1, sizeof(config.MQTT_TOPIC1)); }
       if (webserver.argName(i) == "f_MQTT_TOPIC2") { webserver.arg(webserver.argName(i)).toCharArray(config.MQTT_TOPIC2, sizeof(config.MQTT_TOPIC2)); }
       if (webserver.argName(i) == "f_MQTT_DELIMITER") { webserver.arg(webserver.argName(i)).toCharArray(config.MQTT_DELIMITER, sizeof(config.MQTT_DELIMITER)); }
+      if (webserver.argName(i) == "f_MQTT_ROUTE") { config.MQTT_ROUTE = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_MQTT_DEBUG") { config.MQTT_DEBUG = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_MUX") { config.MUX = webserver.arg(webserver.argName(i)).toInt(); }
       //if (webserver.argName(i) == "f_MUX") { webserver.arg(webserver.argName(i)).toCharArray(config.MUX, sizeof(config.MUX)); }
@@ -178,59 +147,27 @@ void handleCfgSubmit()
       if (webserver.argName(i) == "f_DISPWIDTH") { config.DISPWIDTH = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_DISPHEIGHT") { config.DISPHEIGHT = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_STARTDELAY") { config.STARTDELAY = webserver.arg(webserver.argName(i)).toInt(); }
+      if (webserver.argName(i) == "f_FASTBOOT") { config.FASTBOOT = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_UPDSPEED") { config.UPDSPEED = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_SCREENSAVER") { config.SCREENSAVER = webserver.arg(webserver.argName(i)).toInt(); }
+      if (webserver.argName(i) == "f_LOGORAM") { config.LOGORAM = webserver.arg(webserver.argName(i)).toInt(); }
       if (webserver.argName(i) == "f_PRINTBUF") { config.PRINTBUF = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_ID0") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[0], sizeof(DPL_id[0])); }
-      if (webserver.argName(i) == "f_DPL_ID1") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[1], sizeof(DPL_id[1])); }
-      if (webserver.argName(i) == "f_DPL_ID2") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[2], sizeof(DPL_id[2])); }
-      if (webserver.argName(i) == "f_DPL_ID3") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[3], sizeof(DPL_id[3])); }
-      if (webserver.argName(i) == "f_DPL_ID4") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[4], sizeof(DPL_id[4])); }
-      if (webserver.argName(i) == "f_DPL_ID5") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[5], sizeof(DPL_id[5])); }
-      if (webserver.argName(i) == "f_DPL_ID6") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[6], sizeof(DPL_id[6])); }
-      if (webserver.argName(i) == "f_DPL_ID7") { webserver.arg(webserver.argName(i)).toCharArray(DPL_id[7], sizeof(DPL_id[7])); }
-      if (webserver.argName(i) == "f_DPL_STATION00") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[0], sizeof(DPL_station[0])); }
-      if (webserver.argName(i) == "f_DPL_STATION01") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[1], sizeof(DPL_station[1])); }
-      if (webserver.argName(i) == "f_DPL_STATION02") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[2], sizeof(DPL_station[2])); }
-      if (webserver.argName(i) == "f_DPL_STATION03") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[3], sizeof(DPL_station[3])); }
-      if (webserver.argName(i) == "f_DPL_STATION04") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[4], sizeof(DPL_station[4])); }
-      if (webserver.argName(i) == "f_DPL_STATION05") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[5], sizeof(DPL_station[5])); }
-      if (webserver.argName(i) == "f_DPL_STATION06") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[6], sizeof(DPL_station[6])); }
-      if (webserver.argName(i) == "f_DPL_STATION07") { webserver.arg(webserver.argName(i)).toCharArray(DPL_station[7], sizeof(DPL_station[7])); }
-      if (webserver.argName(i) == "f_DPL_TRACK0") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[0], sizeof(DPL_track[0])); }
-      if (webserver.argName(i) == "f_DPL_TRACK1") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[1], sizeof(DPL_track[1])); }
-      if (webserver.argName(i) == "f_DPL_TRACK2") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[2], sizeof(DPL_track[2])); }
-      if (webserver.argName(i) == "f_DPL_TRACK3") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[3], sizeof(DPL_track[3])); }
-      if (webserver.argName(i) == "f_DPL_TRACK4") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[4], sizeof(DPL_track[4])); }
-      if (webserver.argName(i) == "f_DPL_TRACK5") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[5], sizeof(DPL_track[5])); }
-      if (webserver.argName(i) == "f_DPL_TRACK6") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[6], sizeof(DPL_track[6])); }
-      if (webserver.argName(i) == "f_DPL_TRACK7") { webserver.arg(webserver.argName(i)).toCharArray(DPL_track[7], sizeof(DPL_track[7])); }
-      if (webserver.argName(i) == "f_DPL_FLIP0") { DPL_flip[0] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP1") { DPL_flip[1] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP2") { DPL_flip[2] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP3") { DPL_flip[3] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP4") { DPL_flip[4] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP5") { DPL_flip[5] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP6") { DPL_flip[6] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_FLIP7") { DPL_flip[7] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST0") { DPL_contrast[0] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST1") { DPL_contrast[1] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST2") { DPL_contrast[2] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST3") { DPL_contrast[3] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST4") { DPL_contrast[4] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST5") { DPL_contrast[5] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST6") { DPL_contrast[6] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_CONTRAST7") { DPL_contrast[7] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE0") { DPL_side[0] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE1") { DPL_side[1] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE2") { DPL_side[2] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE3") { DPL_side[3] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE4") { DPL_side[4] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE5") { DPL_side[5] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE6") { DPL_side[6] = webserver.arg(webserver.argName(i)).toInt(); }
-      if (webserver.argName(i) == "f_DPL_SIDE7") { DPL_side[7] = webserver.arg(webserver.argName(i)).toInt(); }
+      if (webserver.argName(i).startsWith("f_DPL_")){
+        String name = webserver.argName(i).substring(2);
+        String value = webserver.arg(webserver.argName(i));
+        char key[20];
+        for (uint8_t d = 0; d < MAXDISP; d++){
+          if (name == dplKey(key, sizeof(key), "ID", d)) { value.toCharArray(DPL_id[d], sizeof(DPL_id[d])); }
+          if (name == dplKey(key, sizeof(key), "STATION", d)) { value.toCharArray(DPL_station[d], sizeof(DPL_station[d])); }
+          if (name == dplKey(key, sizeof(key), "TRACK", d)) { value.toCharArray(DPL_track[d], sizeof(DPL_track[d])); }
+          if (name == dplKey(key, sizeof(key), "FLIP", d)) { DPL_flip[d] = value.toInt(); }
+          if (name == dplKey(key, sizeof(key), "CONTRAST", d)) { DPL_contrast[d] = value.toInt(); }
+          if (name == dplKey(key, sizeof(key), "SIDE", d)) { DPL_side[d] = value.toInt(); }
+        }
+      }
     }
     saveConfiguration(configfile, config);
+    saveSnapshot();
   }
 }
 
@@ -245,16 +182,16 @@ void loadTpl1()
   //uint8_t i = 0;
   //String fbuf = "";
   //fbuf = String(&*fontno[i]);
-  buf1.replace("%TPL_FONT0%", String(fonts[0]));
-  buf1.replace("%TPL_FONT1%", String(fonts[1]));
-  buf1.replace("%TPL_FONT2%", String(fonts[2]));
-  buf1.replace("%TPL_FONT3%", String(fonts[3]));
-  buf1.replace("%TPL_FONT4%", String(fonts[4]));
-  buf1.replace("%TPL_FONT5%", String(fonts[5]));
-  buf1.replace("%TPL_FONT6%", String(fonts[6]));
-  buf1.replace("%TPL_FONT7%", String(fonts[7]));
-  buf1.replace("%TPL_FONT8%", String(fonts[8]));
-  buf1.replace("%TPL_FONT9%", String(fonts[9]));
+  buf1.replace("%TPL_FONT0%", String(FPSTR(fonts[0])));
+  buf1.replace("%TPL_FONT1%", String(FPSTR(fonts[1])));
+  buf1.replace("%TPL_FONT2%", String(FPSTR(fonts[2])));
+  buf1.replace("%TPL_FONT3%", String(FPSTR(fonts[3])));
+  buf1.replace("%TPL_FONT4%", String(FPSTR(fonts[4])));
+  buf1.replace("%TPL_FONT5%", String(FPSTR(fonts[5])));
+  buf1.replace("%TPL_FONT6%", String(FPSTR(fonts[6])));
+  buf1.replace("%TPL_FONT7%", String(FPSTR(fonts[7])));
+  buf1.replace("%TPL_FONT8%", String(FPSTR(fonts[8])));
+  buf1.replace("%TPL_FONT9%", String(FPSTR(fonts[9])));
 
   buf1.replace("%TPL_LOGOID0%", String(logoId[0]));
   buf1.replace("%TPL_LOGOID1%", String(logoId[1]));
@@ -425,6 +362,7 @@ void handleTpl1Submit()
       if (webserver.argName(i) == "f_TPL_LOGO19H") { logoh[19] = webserver.arg(webserver.argName(i)).toInt(); }
     }
     saveTemplate(templatefile);
+    saveSnapshot();
   }
 }
 
@@ -611,6 +549,7 @@ void handleTpl2Submit()
             break;
     case 9: saveTemplateFile(template09);
     }
+    saveSnapshot();
   }
 }
 
@@ -698,7 +637,7 @@ void handleSecSubmit()
 
 
 // UPDATE
-void loadUpdate(String updstatus)
+void loadUpdate(String /*updstatus*/)
 {
   File htmlUpdate = LittleFS.open( "/update.htm", "r" );
   buf1 = htmlUpdate.readString();
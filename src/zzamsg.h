@@ -0,0 +1,390 @@
+// Roc-MQTT-Display ZZAMSG PARSER
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef ZZAMSG_H
+#define ZZAMSG_H
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+// Fields of a ZZAMSG message after the identifier
+// ZZAMSG#Targets#Template#Station#Track#Destination#Departure#Train#TrainType#Message#Spare1#Spare2#
+enum ZZAField {
+  ZZAF_TARGETS,        // Identifier for displays e.g. D01D02
+  ZZAF_TEMPLATE,       // Identifier for the template e.g. T0
+  ZZAF_STATION,        // Name of the station
+  ZZAF_TRACK,          // Track number
+  ZZAF_DESTINATION,    // Destination city
+  ZZAF_DEPARTURE,      // Departure time
+  ZZAF_TRAIN,          // Train number
+  ZZAF_TYPE,           // Train Type for Logo selection
+  ZZAF_MESSAGE,        // Message text
+  ZZAF_SPARE1,         // For future features
+  ZZAF_SPARE2,         // For future features
+  ZZAF_COUNT
+};
+
+// Field of a message, points into the received payload and is not null terminated
+struct ZZASpan {
+  const char *ptr;
+  uint16_t    len;
+};
+
+// Display ID lookup, resolves the IDs of the Targets field to a bitmask of displays
+typedef uint32_t DispMask;         // bit n = display n+1
+
+struct ZZAMsg {
+  ZZASpan  field[ZZAF_COUNT];
+  uint8_t  count;      // number of fields found in the payload, missing fields are empty
+  DispMask mask;       // ZZAMSG v2, displays of this controller addressed by position in addition to the Targets field
+};
+
+
+// Length of the field separator at s, "#" or the MQTT delimiter, 0 if there is no separator
+inline size_t zzaSeparator(const char *s, const char *end, const char *delim, size_t dlen)
+{
+  if (*s == '#'){
+    return 1;
+  }
+  if (dlen > 0 && (size_t)(end - s) >= dlen && memcmp(s, delim, dlen) == 0){
+    return dlen;
+  }
+  return 0;
+}
+
+
+// Split a ZZAMSG payload of len bytes into fields in one pass without copying.
+// Fields are separated by "#" or by delim (MQTT_DELIMITER, may be empty).
+// Returns false if the payload doesn't start with the ZZAMSG identifier.
+inline bool zzaParse(const char *buf, size_t len, const char *delim, ZZAMsg &msg)
+{
+  const char *end = buf + len;
+  size_t dlen = (delim != nullptr) ? strlen(delim) : 0;
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    msg.field[f].ptr = end;
+    msg.field[f].len = 0;
+  }
+  msg.count = 0;
+  msg.mask = 0;
+
+  if (len <= 6 || memcmp(buf, "ZZAMSG", 6) != 0){
+    return false;
+  }
+  const char *s = buf + 6;
+  size_t n = zzaSeparator(s, end, delim, dlen);
+  if (n == 0){
+    return false;
+  }
+  s += n;
+
+  const char *start = s;
+  while (s < end && msg.count < ZZAF_COUNT){
+    n = zzaSeparator(s, end, delim, dlen);
+    if (n == 0){
+      s++;
+      continue;
+    }
+    msg.field[msg.count].ptr = start;
+    msg.field[msg.count].len = s - start;
+    msg.count++;
+    s += n;
+    start = s;
+  }
+  // Last field without a closing separator
+  if (start < end && msg.count < ZZAF_COUNT){
+    msg.field[msg.count].ptr = start;
+    msg.field[msg.count].len = end - start;
+    msg.count++;
+  }
+  return true;
+}
+
+
+// Template number 0-9 of the Template field (e.g. T3), reads only the digits of the field, 0 if there are none or the number is > 9
+inline uint8_t zzaTemplate(const ZZASpan &f)
+{
+  uint8_t t = 0;
+  for (uint16_t k = 1; k < f.len && f.ptr[k] >= '0' && f.ptr[k] <= '9'; k++){   // skip the leading T
+    t = t * 10 + (f.ptr[k] - '0');
+    if (t > 9){
+      return 0;
+    }
+  }
+  return t;
+}
+
+
+// ZZAMSG v2, length-prefixed records instead of separators, selected by the magic byte
+//   0xA5 '2' then records of  tag  length  value
+// tag = 0x20 + ZZAField or 0x20 + ZZA2_MASK, length = 0x20 + number of value bytes (max 223), value = UTF-8 text.
+// ZZA2_MASK is the hex bitmask of the displays of this controller, bit n = display n+1.
+// A ZZA2_NEXT record (length 0) starts the next message, one payload can carry several messages.
+// No header byte is 0, the MQTT client hands over payloads as null terminated strings.
+// Missing fields are empty, unknown tags are skipped.
+#define ZZA2_MAGIC   0xA5
+#define ZZA2_VERSION '2'
+#define ZZA2_MASK    16
+#define ZZA2_NEXT    17
+
+
+// True if the payload is a ZZAMSG v2 message
+inline bool zza2Is(const char *buf, size_t len)
+{
+  return len >= 2 && (uint8_t)buf[0] == ZZA2_MAGIC && buf[1] == ZZA2_VERSION;
+}
+
+
+// Read the message at s of a ZZAMSG v2 payload (after the magic byte and version) without scanning for separators.
+// Returns the start of the next message, end after the last message, nullptr if a record is truncated.
+inline const char *zza2Parse(const char *s, const char *end, ZZAMsg &msg)
+{
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    msg.field[f].ptr = end;
+    msg.field[f].len = 0;
+  }
+  msg.count = 0;
+  msg.mask = 0;
+
+  while (s < end){
+    if (end - s < 2 || (uint8_t)s[0] < 0x20 || (uint8_t)s[1] < 0x20){
+      return nullptr;
+    }
+    uint8_t tag = (uint8_t)s[0] - 0x20;
+    uint8_t l = (uint8_t)s[1] - 0x20;
+    s += 2;
+    if (end - s < l){
+      return nullptr;
+    }
+    if (tag < ZZAF_COUNT){
+      msg.field[tag].ptr = s;
+      msg.field[tag].len = l;
+      if (tag >= msg.count){
+        msg.count = tag + 1;
+      }
+    }
+    else if (tag == ZZA2_MASK){
+      for (uint8_t k = 0; k < l; k++){
+        char c = s[k];
+        uint8_t d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : 0;
+        msg.mask = (msg.mask << 4) | d;
+      }
+    }
+    else if (tag == ZZA2_NEXT){
+      return s + l;
+    }
+    s += l;
+  }
+  return end;
+}
+
+
+// Write msg as one ZZAMSG v2 message into out (null terminated), fields are cut to 223 bytes at a UTF-8 character boundary.
+// Returns the length, 0 if out is too small.
+inline size_t zza2Encode(const ZZAMsg &msg, char *out, size_t size)
+{
+  if (size < 3){
+    return 0;
+  }
+  size_t n = 0;
+  out[n++] = (char)ZZA2_MAGIC;
+  out[n++] = ZZA2_VERSION;
+  char hex[9] = "";
+  uint8_t hexLen = 0;
+  for (int8_t k = 28; k >= 0; k -= 4){
+    uint8_t d = (msg.mask >> k) & 0x0F;
+    if (d != 0 || hexLen > 0){
+      hex[hexLen++] = "0123456789abcdef"[d];
+    }
+  }
+  for (uint8_t f = 0; f <= ZZAF_COUNT; f++){
+    const char *v = (f < ZZAF_COUNT) ? msg.field[f].ptr : hex;
+    size_t l = (f < ZZAF_COUNT) ? msg.field[f].len : hexLen;
+    if (l == 0){
+      continue;
+    }
+    if (l > 223){
+      l = 223;
+      while (l > 0 && (v[l] & 0xC0) == 0x80){
+        l--;
+      }
+    }
+    if (n + 2 + l >= size){
+      return 0;
+    }
+    out[n++] = (char)(0x20 + ((f < ZZAF_COUNT) ? f : ZZA2_MASK));
+    out[n++] = (char)(0x20 + l);
+    memcpy(out + n, v, l);
+    n += l;
+  }
+  out[n] = '\0';
+  return n;
+}
+
+
+// Length of the ZZAMSG record at s in a ZZABATCH payload, up to the next ZZAMSG identifier or end
+// ZZABATCH#ZZAMSG#D01#T0#...#ZZAMSG#D02#T0#...#....
+inline size_t zzaBatchRecord(const char *s, const char *end)
+{
+  for (const char *p = s + 6; p + 6 <= end; p++){
+    if (*p == 'Z' && memcmp(p, "ZZAMSG", 6) == 0){
+      return p - s;
+    }
+  }
+  return end - s;
+}
+
+
+// Variables in messages, bit n = varName[n] is used
+#define VAR_RRTIME   0x01
+#define VAR_RRDATE   0x02
+#define VAR_NTPTIME  0x04
+#define VAR_NTPDATE  0x08
+#define VAR_ALL      0x0F
+const char *const varName[4] = { "{rrtime}", "{rrdate}", "{ntptime}", "{ntpdate}" };
+
+// Compiled message, literal text of the received message or a variable slot
+struct VarSeg {
+  uint8_t  var;                    // 0 = literal, n = varName[n-1]
+  uint8_t  pos;                    // literal, start in the received message
+  uint8_t  len;                    // literal, length
+};
+
+struct DisplayId {
+  char     id[4];
+  uint8_t  len;
+  DispMask mask;                   // all displays with this ID
+};
+
+
+// Copy len bytes of src into a field buffer of the display state, cut at a UTF-8 character boundary
+inline void setField(char *field, size_t size, const char *src, int len)
+{
+  if (len < 0){
+    len = 0;
+  }
+  if ((size_t)len >= size){
+    len = size - 1;
+    // Don't split a multibyte character
+    while (len > 0 && (src[len] & 0xC0) == 0x80){
+      len--;
+    }
+  }
+  memcpy(field, src, len);
+  field[len] = '\0';
+}
+
+
+// Next display ID of the Targets field (e.g. D01D02) at s, each ID is a prefix followed by a number.
+// id is set to the start of the ID, returns the end of the ID.
+inline const char *targetNext(const char *s, const char *end, const char *&id)
+{
+  // Skip separators between IDs
+  while (s < end && (*s == ' ' || *s == ',' || *s == ';')){
+    s++;
+  }
+  id = s;
+  while (s < end && !isdigit((unsigned char)*s) && *s != ' ' && *s != ',' && *s != ';'){
+    s++;
+  }
+  while (s < end && isdigit((unsigned char)*s)){
+    s++;
+  }
+  return s;
+}
+
+
+// Resolve the Targets field (e.g. D01D02) to a bitmask of displays with the ID table ids.
+// IDs must match completely, D1 doesn't address D10.
+inline DispMask targetMask(const char *s, uint16_t len, const DisplayId *ids, uint8_t count)
+{
+  DispMask mask = 0;
+  const char *end = s + len;
+  while (s < end){
+    const char *id;
+    s = targetNext(s, end, id);
+    for (uint8_t k = 0; k < count; k++){
+      if (ids[k].len == s - id && memcmp(ids[k].id, id, s - id) == 0){
+        mask |= ids[k].mask;
+        break;
+      }
+    }
+  }
+  return mask;
+}
+
+
+// Compile src into literal segments and slots for the variables in allowed (VAR_*), returns the number of segments.
+// The variables found are added to vars.
+inline uint8_t compileVars(const char *src, VarSeg *seg, uint8_t max, uint8_t allowed, uint8_t &vars)
+{
+  uint8_t n = 0;
+  const char *s = src;
+  const char *lit = src;
+  while (*s != '\0'){
+    uint8_t var = 0;
+    size_t skip = 0;
+    // Room for the literal before, the variable and the literal after it
+    if (*s == '{' && n + 3 <= max){
+      for (uint8_t k = 0; k < 4; k++){
+        skip = strlen(varName[k]);
+        if ((allowed & (1 << k)) && strncmp(s, varName[k], skip) == 0){
+          var = k + 1;
+          break;
+        }
+      }
+    }
+    if (var == 0){
+      s++;
+      continue;
+    }
+    if (s > lit){
+      seg[n++] = { 0, (uint8_t)(lit - src), (uint8_t)(s - lit) };
+    }
+    seg[n++] = { var, 0, 0 };
+    vars |= 1 << (var - 1);
+    s += skip;
+    lit = s;
+  }
+  if (s > lit){
+    seg[n++] = { 0, (uint8_t)(lit - src), (uint8_t)(s - lit) };
+  }
+  return n;
+}
+
+
+// Write the compiled src with the variable values (in the order of varName[]) into field, cut at a UTF-8 character boundary
+inline void expandVars(char *field, size_t size, const char *src, const VarSeg *seg, uint8_t count, const char *const *values)
+{
+  size_t n = 0;
+  for (uint8_t k = 0; k < count; k++){
+    const char *v;
+    size_t l;
+    if (seg[k].var == 0){
+      v = src + seg[k].pos;
+      l = seg[k].len;
+    }
+    else {
+      v = values[seg[k].var - 1];
+      l = strlen(v);
+    }
+    if (n + l >= size){
+      if (seg[k].var == 0){
+        // Copy the part of the literal that fits, don't split a multibyte character
+        l = size - 1 - n;
+        while (l > 0 && (v[l] & 0xC0) == 0x80){
+          l--;
+        }
+        memcpy(field + n, v, l);
+        n += l;
+      }
+      break;
+    }
+    memcpy(field + n, v, l);
+    n += l;
+  }
+  field[n] = '\0';
+}
+
+#endif
@@ -0,0 +1,118 @@
+// Roc-MQTT-Display HOST BENCHMARK - ZZAMSG parser
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Time per parse and payload bytes of typical announcements with the parser before zzamsg.h, zzaParse() and zza2Parse().
+//   bench_parse [iterations]
+
+#include <chrono>
+#include <stdlib.h>
+#include <string>
+#include <zzamsg.h>
+#include "check.h"
+
+static const char *const payloads[] = {
+  "ZZAMSG#D01#T0#Bhf01#1#####Zugdurchfahrt###....",
+  "ZZAMSG#D01#T1#Bhf01#2#Köln-Bonn#10:22#ICE 597#ICE#5min Verspätung - Vorsicht an der Bahnsteigkante###....",
+  "ZZAMSG#D01D02#T0#Hamburg-Hbf#4#München Hbf#08:17#ICE 597#ICE#Abfahrt heute auf Gleis 4 - Wagenreihung in umgekehrter Reihenfolge###....",
+};
+
+static volatile size_t sink;
+static char v2[3][256];
+static size_t v2Len[3];
+
+
+// The parser before zzamsg.h with std::string in place of String, substring(a, b) = substr(a, b - a)
+static void legacyParse(const std::string &payload2, const std::string &delim, std::string *field)
+{
+  size_t at = payload2.find("ZZAMSG");
+  std::string pld = payload2.substr(at, payload2.size() - 4 - at);
+  if (pld.substr(0, 6) != "ZZAMSG"){
+    return;
+  }
+  if (!delim.empty()){
+    for (size_t p = pld.find(delim); p != std::string::npos; p = pld.find(delim, p + 1)){
+      pld.replace(p, delim.size(), "#");
+    }
+  }
+  // Every field start searched in a copy of the rest of the payload
+  int start[11];
+  start[0] = pld.find("ZZAMSG#") + 7;
+  for (uint8_t k = 1; k < 11; k++){
+    start[k] = start[k - 1] + 1 + (int)pld.substr(start[k - 1]).find('#');
+  }
+  for (uint8_t k = 0; k < 9; k++){
+    field[k] = pld.substr(start[k], start[k + 1] - 1 - start[k]);
+  }
+}
+
+
+// Average ns per call of fn over n iterations of all payloads
+template <class F>
+static double timeNs(unsigned long n, F fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned long k = 0; k < n; k++){
+    for (const char *p : payloads){
+      fn(p);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / (n * (sizeof(payloads) / sizeof(payloads[0])));
+}
+
+
+int main(int argc, char **argv)
+{
+  unsigned long n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 200000;
+
+  // Both parsers must read the same fields
+  for (const char *p : payloads){
+    std::string field[9];
+    legacyParse(p, "", field);
+    ZZAMsg msg;
+    zzaParse(p, strlen(p) - 4, "", msg);
+    for (uint8_t k = 0; k < 9; k++){
+      CHECK_SPAN(msg.field[k].ptr, msg.field[k].len, field[k].c_str());
+    }
+  }
+
+  // The same messages as ZZAMSG v2 payloads
+  size_t textBytes = 0, v2Bytes = 0;
+  for (uint8_t k = 0; k < 3; k++){
+    ZZAMsg msg;
+    zzaParse(payloads[k], strlen(payloads[k]) - 4, "", msg);
+    v2Len[k] = zza2Encode(msg, v2[k], sizeof(v2[k]));
+    ZZAMsg back;
+    CHECK(zza2Parse(v2[k] + 2, v2[k] + v2Len[k], back) == v2[k] + v2Len[k]);
+    for (uint8_t f = 0; f < 9; f++){
+      CHECK(back.field[f].len == msg.field[f].len && memcmp(back.field[f].ptr, msg.field[f].ptr, msg.field[f].len) == 0);
+    }
+    textBytes += strlen(payloads[k]);
+    v2Bytes += v2Len[k];
+  }
+
+  double legacy = timeNs(n, [](const char *p){
+    std::string field[9];
+    legacyParse(p, "", field);
+    sink += field[ZZAF_MESSAGE].size();
+  });
+  double single = timeNs(n, [](const char *p){
+    ZZAMsg msg;
+    zzaParse(p, strlen(p) - 4, "", msg);
+    sink += msg.field[ZZAF_MESSAGE].len;
+  });
+  uint8_t k = 0;
+  double binary = timeNs(n, [&k](const char *){
+    ZZAMsg msg;
+    zza2Parse(v2[k] + 2, v2[k] + v2Len[k], msg);
+    sink += msg.field[ZZAF_MESSAGE].len;
+    k = (k + 1) % 3;
+  });
+  printf("parser,ns_per_message,payload_bytes\n");
+  printf("substring,%.0f,%zu\n", legacy, textBytes);
+  printf("zzaParse,%.0f,%zu\n", single, textBytes);
+  printf("zza2Parse,%.0f,%zu\n", binary, v2Bytes);
+  return checkFailures() == 0 ? 0 : 1;
+}
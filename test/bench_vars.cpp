@@ -0,0 +1,207 @@
+// Roc-MQTT-Display HOST BENCHMARK - message variables
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Time per clock tick of updVar() on eight displays, with the expansion before compileVars() and with the compiled
+// messages, for a tick that changes {rrtime} and for one that changes nothing. The text width the sketch measures for
+// every updated ticker before compileVars() isn't included, render --clock counts it.
+//   bench_vars [iterations]
+
+#include <chrono>
+#include <stdlib.h>
+#include <string>
+#include <zzamsg.h>
+#include "check.h"
+
+#define DISPLAYS 8
+#define MSGLEN   201               // ZZA_MSGLEN, ZZA_SHORTLEN, ZZA_MSGSEGS and ZZA_DEPSEGS of the sketch
+#define SHORTLEN 21
+#define MSGSEGS  9
+#define DEPSEGS  3
+
+// Two displays with the railroad time, one with the NTP date and time, five with a train
+static const char *const messages[DISPLAYS][2] = {
+  { "{rrtime} Uhr", "" },
+  { "{rrtime} Uhr", "" },
+  { "{ntpdate} {ntptime}", "" },
+  { "Abfahrt heute auf Gleis 4 - Vorsicht an der Bahnsteigkante", "08:17" },
+  { "5min Verspätung - 5min delayed", "10:22" },
+  { "", "16:43" },
+  { "Ersatzfahrplan wg. Bahnstreik", "" },
+  { "Wagenreihung geändert", "11:05" },
+};
+
+struct Display {
+  char    MessageO[MSGLEN];
+  char    DepartureO[SHORTLEN];
+  char    Message[MSGLEN];
+  char    MessageLoop[MSGLEN + 5];
+  char    Departure[SHORTLEN];
+  VarSeg  msgSegs[MSGSEGS];
+  VarSeg  depSegs[DEPSEGS];
+  uint8_t msgSegCount;
+  uint8_t depSegCount;
+  uint8_t vars;
+};
+
+static Display before[DISPLAYS], after[DISPLAYS];
+static const char *values[4] = { "18:40", "12.02.2021", "18:40", "01.03.2024" };
+static char varLast[4][12];
+static volatile size_t sink;
+
+
+// expandVars() before compileVars(), scans the received text for '{' on every call
+static void legacyExpand(char *field, size_t size, const char *src, bool rrtimeOnly)
+{
+  size_t n = 0;
+  while (*src != '\0'){
+    const char *v = NULL;
+    uint8_t skip = 0;
+    if (*src == '{'){
+      for (uint8_t k = 0; k < 4 && v == NULL; k++){
+        skip = strlen(varName[k]);
+        if ((k == 0 || !rrtimeOnly) && strncmp(src, varName[k], skip) == 0){
+          v = values[k];
+        }
+      }
+    }
+    if (v != NULL){
+      size_t l = strlen(v);
+      if (n + l >= size){
+        break;
+      }
+      memcpy(field + n, v, l);
+      n += l;
+      src += skip;
+    }
+    else {
+      if (n + 1 >= size){
+        break;
+      }
+      field[n++] = *src++;
+    }
+  }
+  field[n] = '\0';
+}
+
+
+// Show the expanded message and departure when they changed, returns 1 if they did
+static uint8_t show(Display &z, const char *msg, const char *dep)
+{
+  if (strcmp(msg, z.Message) == 0 && strcmp(dep, z.Departure) == 0){
+    return 0;
+  }
+  strcpy(z.Message, msg);
+  strcpy(z.MessageLoop, " +++ ");
+  strcat(z.MessageLoop, z.Message);
+  strcpy(z.Departure, dep);
+  return 1;
+}
+
+
+// updVar() before compileVars(): every display expanded on every tick, returns the displays expanded
+static uint8_t legacyTick()
+{
+  for (uint8_t i = 0; i < DISPLAYS; i++){
+    char msg[MSGLEN];
+    char dep[SHORTLEN];
+    legacyExpand(msg, sizeof(msg), before[i].MessageO, false);
+    legacyExpand(dep, sizeof(dep), before[i].DepartureO, true);
+    sink += show(before[i], msg, dep);
+  }
+  return DISPLAYS;
+}
+
+
+// updVar() with compiled messages: only the displays using a changed variable, returns the displays expanded
+static uint8_t compiledTick()
+{
+  uint8_t changed = 0;
+  for (uint8_t k = 0; k < 4; k++){
+    if (strcmp(values[k], varLast[k]) != 0){
+      strlcpy(varLast[k], values[k], sizeof(varLast[k]));
+      changed |= 1 << k;
+    }
+  }
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < DISPLAYS && changed != 0; i++){
+    Display &z = after[i];
+    if (z.vars & changed){
+      char msg[MSGLEN];
+      char dep[SHORTLEN];
+      expandVars(msg, sizeof(msg), z.MessageO, z.msgSegs, z.msgSegCount, values);
+      expandVars(dep, sizeof(dep), z.DepartureO, z.depSegs, z.depSegCount, values);
+      sink += show(z, msg, dep);
+      n++;
+    }
+  }
+  return n;
+}
+
+
+// Average ns per call of tick over n ticks, the railroad time changes every tick when change is true.
+// expanded = displays expanded per tick.
+template <class F>
+static double timeNs(unsigned long n, bool change, F tick, uint8_t &expanded)
+{
+  static const char *const times[2] = { "18:40", "18:41" };
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned long k = 0; k < n; k++){
+    if (change){
+      values[0] = times[k & 1];
+    }
+    expanded = tick();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+
+int main(int argc, char **argv)
+{
+  unsigned long n = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+
+  for (uint8_t i = 0; i < DISPLAYS; i++){
+    Display *d[2] = { &before[i], &after[i] };
+    for (Display *z : d){
+      memset(z, 0, sizeof(*z));
+      strlcpy(z->MessageO, messages[i][0], sizeof(z->MessageO));
+      strlcpy(z->DepartureO, messages[i][1], sizeof(z->DepartureO));
+    }
+    after[i].msgSegCount = compileVars(after[i].MessageO, after[i].msgSegs, MSGSEGS, VAR_ALL, after[i].vars);
+    after[i].depSegCount = compileVars(after[i].DepartureO, after[i].depSegs, DEPSEGS, VAR_RRTIME, after[i].vars);
+    // Expanded once when the message is received
+    char msg[MSGLEN];
+    char dep[SHORTLEN];
+    expandVars(msg, sizeof(msg), after[i].MessageO, after[i].msgSegs, after[i].msgSegCount, values);
+    expandVars(dep, sizeof(dep), after[i].DepartureO, after[i].depSegs, after[i].depSegCount, values);
+    show(after[i], msg, dep);
+  }
+  for (uint8_t k = 0; k < 4; k++){
+    strlcpy(varLast[k], values[k], sizeof(varLast[k]));
+  }
+
+  // Both show the same text after every tick
+  for (uint8_t k = 0; k < 4; k++){
+    values[0] = (k & 1) ? "18:41" : "18:40";
+    legacyTick();
+    compiledTick();
+    for (uint8_t i = 0; i < DISPLAYS; i++){
+      CHECK(strcmp(before[i].Message, after[i].Message) == 0);
+      CHECK(strcmp(before[i].Departure, after[i].Departure) == 0);
+    }
+  }
+
+  uint8_t legacyChanged, compiledChanged, legacySame, compiledSame;
+  double a = timeNs(n, true, legacyTick, legacyChanged);
+  double b = timeNs(n, true, compiledTick, compiledChanged);
+  double c = timeNs(n, false, legacyTick, legacySame);
+  double d = timeNs(n, false, compiledTick, compiledSame);
+  printf("updvar,tick,ns_per_tick,displays_expanded\n");
+  printf("before,rrtime changed,%.0f,%u\n", a, legacyChanged);
+  printf("compiled,rrtime changed,%.0f,%u\n", b, compiledChanged);
+  printf("before,nothing changed,%.0f,%u\n", c, legacySame);
+  printf("compiled,nothing changed,%.0f,%u\n", d, compiledSame);
+  return checkFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Roc-MQTT-Display HOST TESTS
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef CHECK_H
+#define CHECK_H
+#include <stdio.h>
+#include <string.h>
+
+// Test functions register themselves, test_main.cpp runs the tests of a group
+struct TestCase {
+  const char *group;
+  const char *name;
+  void      (*fn)();
+  TestCase   *next;
+};
+
+
+// All registered tests
+inline TestCase *&testList()
+{
+  static TestCase *list = nullptr;
+  return list;
+}
+
+
+// Failed checks so far
+inline int &checkFailures()
+{
+  static int n = 0;
+  return n;
+}
+
+
+// Append a test, tests run in the order of their files and definitions
+struct TestRegister {
+  explicit TestRegister(TestCase &t)
+  {
+    TestCase **p = &testList();
+    while (*p != nullptr){
+      p = &(*p)->next;
+    }
+    *p = &t;
+  }
+};
+
+#define TEST(group, name) \
+  static void group##_##name(); \
+  static TestCase group##_##name##_case = { #group, #name, group##_##name, nullptr }; \
+  static TestRegister group##_##name##_register(group##_##name##_case); \
+  static void group##_##name()
+
+// Count and report a failed condition, the test continues
+#define CHECK(cond) do { \
+    if (!(cond)){ \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      checkFailures()++; \
+    } \
+  } while (0)
+
+// Compare a field of len bytes with a string
+#define CHECK_SPAN(ptr, len, str) CHECK((size_t)(len) == strlen(str) && memcmp((ptr), (str), (len)) == 0)
+
+
+// strlcpy of the Arduino cores, glibc has it only from 2.38
+#if !defined(__GLIBC__) || __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  size_t len = strlen(src);
+  if (size > 0){
+    size_t n = (len < size - 1) ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+#endif
@@ -0,0 +1,298 @@
+// Roc-MQTT-Display HOST BUILD - Arduino core
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// The parts of the ESP8266 Arduino core used by the sketch, time is simulated and only advances with delay() or hostAdvance().
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH        1
+#define LOW         0
+#define INPUT       0
+#define OUTPUT      1
+#define LED_BUILTIN 2
+#define DEC         10
+#define HEX         16
+#define BIN         2
+
+#define PROGMEM
+#define ICACHE_RODATA_ATTR
+#define PGM_P                 const char *
+#define PSTR(s)               (s)
+#define pgm_read_byte(p)      (*(const uint8_t *)(p))
+#define pgm_read_word(p)      (*(const uint16_t *)(p))
+#define pgm_read_dword(p)     (*(const uint32_t *)(p))
+#define pgm_read_ptr(p)       (*(void *const *)(p))
+#define memcpy_P              memcpy
+#define strlen_P              strlen
+#define strncpy_P             strncpy
+#define strcmp_P              strcmp
+#define strcpy_P              strcpy
+
+class __FlashStringHelper;
+#define F(s)     ((const __FlashStringHelper *)(s))
+#define FPSTR(s) ((const __FlashStringHelper *)(s))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+long random(long max);
+long random(long min, long max);
+time_t hostTime(time_t *t);        // time() of the sketch, simulated, starts at 2024-03-01 12:00:00 UTC
+
+#if !defined(__GLIBC__) || __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+
+
+// Counts the String objects constructed, copies included, see render --clock
+extern uint32_t hostStrings;
+struct HostStringCount {
+  HostStringCount() { hostStrings++; }
+  HostStringCount(const HostStringCount &) { hostStrings++; }
+  HostStringCount &operator=(const HostStringCount &) { return *this; }
+};
+
+// Arduino String on top of std::string
+class String {
+public:
+  std::string s;
+  HostStringCount counted;
+
+  String() {}
+  String(const char *c) { if (c != nullptr) s = c; }
+  String(const std::string &c) : s(c) {}
+  String(const __FlashStringHelper *c) { if (c != nullptr) s = (const char *)c; }
+  explicit String(char c) : s(1, c) {}
+  explicit String(unsigned char v, unsigned char base = 10) { number(v, base); }
+  explicit String(int v, unsigned char base = 10) { number(v, base); }
+  explicit String(unsigned int v, unsigned char base = 10) { number(v, base); }
+  explicit String(long v, unsigned char base = 10) { number(v, base); }
+  explicit String(unsigned long v, unsigned char base = 10) { number(v, base); }
+  explicit String(long long v, unsigned char base = 10) { number(v, base); }
+  explicit String(unsigned long long v, unsigned char base = 10) { number(v, base); }
+  explicit String(float v, unsigned char digits = 2) { real(v, digits); }
+  explicit String(double v, unsigned char digits = 2) { real(v, digits); }
+
+  unsigned int length() const { return s.size(); }
+  const char *c_str() const { return s.c_str(); }
+  bool isEmpty() const { return s.empty(); }
+  bool reserve(unsigned int n) { s.reserve(n); return true; }
+
+  char charAt(unsigned int i) const { return (i < s.size()) ? s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char &operator[](unsigned int i) { return s[i]; }
+  void setCharAt(unsigned int i, char c) { if (i < s.size()) s[i] = c; }
+
+  String substring(unsigned int from) const { return (from < s.size()) ? String(s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= s.size()) return String();
+    return String(s.substr(from, std::min<size_t>(to, s.size()) - from));
+  }
+  int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+  int indexOf(const String &x, unsigned int from = 0) const { return pos(s.find(x.s, from)); }
+  int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+  int lastIndexOf(const String &x) const { return pos(s.rfind(x.s)); }
+  bool startsWith(const String &x) const { return s.compare(0, x.s.size(), x.s) == 0; }
+  bool endsWith(const String &x) const { return s.size() >= x.s.size() && s.compare(s.size() - x.s.size(), x.s.size(), x.s) == 0; }
+  bool equals(const String &x) const { return s == x.s; }
+
+  void replace(const String &from, const String &to) {
+    if (from.s.empty()) return;
+    for (size_t p = 0; (p = s.find(from.s, p)) != std::string::npos; p += to.s.size()) s.replace(p, from.s.size(), to.s);
+  }
+  void replace(char from, char to) { std::replace(s.begin(), s.end(), from, to); }
+  void remove(unsigned int from) { if (from < s.size()) s.erase(from); }
+  void remove(unsigned int from, unsigned int n) { if (from < s.size()) s.erase(from, n); }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    size_t b = s.find_last_not_of(" \t\r\n");
+    s = (a == std::string::npos) ? std::string() : s.substr(a, b - a + 1);
+  }
+  void toUpperCase() { for (char &c : s) c = toupper((unsigned char)c); }
+  void toLowerCase() { for (char &c : s) c = tolower((unsigned char)c); }
+  long toInt() const { return atol(s.c_str()); }
+  float toFloat() const { return atof(s.c_str()); }
+  void toCharArray(char *buf, unsigned int size) const { if (size > 0) { size_t n = std::min<size_t>(s.size(), size - 1); memcpy(buf, s.data(), n); buf[n] = '\0'; } }
+  void getBytes(unsigned char *buf, unsigned int size) const { toCharArray((char *)buf, size); }
+
+  bool concat(const String &x) { s += x.s; return true; }
+  bool concat(const char *x) { if (x != nullptr) s += x; return true; }
+  bool concat(const char *x, unsigned int n) { s.append(x, n); return true; }
+  bool concat(char c) { s += c; return true; }
+  bool concat(int v) { s += String(v).s; return true; }
+  bool concat(unsigned int v) { s += String(v).s; return true; }
+  bool concat(long v) { s += String(v).s; return true; }
+  bool concat(unsigned long v) { s += String(v).s; return true; }
+  bool concat(double v) { s += String(v).s; return true; }
+
+  String &operator+=(const String &x) { s += x.s; return *this; }
+  String &operator+=(const char *x) { if (x != nullptr) s += x; return *this; }
+  String &operator+=(const __FlashStringHelper *x) { s += (const char *)x; return *this; }
+  String &operator+=(char c) { s += c; return *this; }
+  String &operator+=(unsigned char v) { s += String(v).s; return *this; }
+  String &operator+=(int v) { s += String(v).s; return *this; }
+  String &operator+=(unsigned int v) { s += String(v).s; return *this; }
+  String &operator+=(long v) { s += String(v).s; return *this; }
+  String &operator+=(unsigned long v) { s += String(v).s; return *this; }
+  String &operator+=(double v) { s += String(v).s; return *this; }
+
+  bool operator==(const String &x) const { return s == x.s; }
+  bool operator==(const char *x) const { return s == (x != nullptr ? x : ""); }
+  bool operator!=(const String &x) const { return s != x.s; }
+  bool operator!=(const char *x) const { return !(*this == x); }
+  bool operator<(const String &x) const { return s < x.s; }
+
+private:
+  static int pos(size_t p) { return (p == std::string::npos) ? -1 : (int)p; }
+  template <class T> void number(T v, unsigned char base) {
+    if (base == 10) { s = std::to_string(v); return; }
+    bool neg = v < 0;
+    unsigned long long u = neg ? (unsigned long long)(-(long long)v) : (unsigned long long)v;
+    do { s.insert(s.begin(), "0123456789abcdef"[u % base]); u /= base; } while (u > 0);
+    if (neg) s.insert(s.begin(), '-');
+  }
+  void real(double v, unsigned char digits) { char b[64]; snprintf(b, sizeof(b), "%.*f", digits, v); s = b; }
+};
+
+inline String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+inline String operator+(const String &a, const char *b) { return String(a.s + (b != nullptr ? b : "")); }
+inline String operator+(const char *a, const String &b) { return String(std::string(a != nullptr ? a : "") + b.s); }
+inline String operator+(const String &a, const __FlashStringHelper *b) { return String(a.s + (const char *)b); }
+inline String operator+(const String &a, char b) { return String(a.s + b); }
+inline String operator+(const String &a, int b) { return a + String(b); }
+inline String operator+(const String &a, unsigned int b) { return a + String(b); }
+inline String operator+(const String &a, long b) { return a + String(b); }
+inline String operator+(const String &a, unsigned long b) { return a + String(b); }
+inline String operator+(const String &a, double b) { return a + String(b); }
+inline bool operator==(const char *a, const String &b) { return b == a; }
+
+
+// Print, everything ends in write()
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t size) { size_t n = 0; while (size-- > 0) n += write(*buf++); return n; }
+  size_t write(const char *str) { return (str != nullptr) ? write((const uint8_t *)str, strlen(str)) : 0; }
+  size_t write(const char *buf, size_t size) { return write((const uint8_t *)buf, size); }
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+  size_t print(const __FlashStringHelper *s) { return write((const char *)s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+  size_t print(unsigned long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+  size_t print(long long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+  size_t print(unsigned long long v, int base = DEC) { return print(String(v, (unsigned char)base)); }
+  size_t print(double v, int digits = 2) { return print(String(v, (unsigned char)digits)); }
+
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list arg;
+    va_start(arg, format);
+    int n = vsnprintf(buf, sizeof(buf), format, arg);
+    va_end(arg);
+    return write((const uint8_t *)buf, std::min<size_t>(n, sizeof(buf) - 1));
+  }
+  size_t printf_P(PGM_P format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list arg;
+    va_start(arg, format);
+    int n = vsnprintf(buf, sizeof(buf), format, arg);
+    va_end(arg);
+    return write((const uint8_t *)buf, std::min<size_t>(n, sizeof(buf) - 1));
+  }
+  void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  size_t readBytes(char *buf, size_t size) { size_t n = 0; int c; while (n < size && (c = read()) >= 0) buf[n++] = (char)c; return n; }
+  size_t readBytes(uint8_t *buf, size_t size) { return readBytes((char *)buf, size); }
+  String readString() { String r; int c; while ((c = read()) >= 0) r += (char)c; return r; }
+  String readStringUntil(char t) { String r; int c; while ((c = read()) >= 0 && c != t) r += (char)c; return r; }
+  void setTimeout(unsigned long) {}
+};
+
+// Serial output goes to stdout when the environment variable RMD_SERIAL is set
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  void end() {}
+  void setDebugOutput(bool) {}
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override;
+  using Print::write;
+};
+extern HardwareSerial Serial;
+
+
+class IPAddress {
+public:
+  uint8_t b[4] = { 127, 0, 0, 1 };
+  String toString() const { char s[16]; snprintf(s, sizeof(s), "%u.%u.%u.%u", b[0], b[1], b[2], b[3]); return String(s); }
+  operator uint32_t() const { return b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24; }
+};
+
+
+class EspClass {
+public:
+  void restart() { exit(3); }
+  void reset() { exit(3); }
+  uint32_t getChipId() { return 0x00123456; }
+  uint32_t getFreeHeap() { return 40000; }
+  uint32_t getMaxFreeBlockSize() { return 30000; }
+  uint8_t getHeapFragmentation() { return 25; }
+  uint32_t getMaxAllocHeap() { return 30000; }
+  uint32_t getHeapSize() { return 80000; }
+  uint32_t getMinFreeHeap() { return 30000; }
+  void getHeapStats(uint32_t *hfree, uint16_t *hmax, uint8_t *hfrag) { *hfree = 40000; *hmax = 30000; *hfrag = 25; }
+  uint32_t getFlashChipSize() { return 4194304; }
+  uint32_t getFlashChipRealSize() { return 4194304; }
+  uint32_t getFreeSketchSpace() { return 1000000; }
+  uint32_t getSketchSize() { return 500000; }
+  uint32_t getCpuFreqMHz() { return 80; }
+  uint32_t getCycleCount() { return micros() * 80; }
+  const char *getChipModel() { return "host"; }
+  String getResetReason() { return String("host"); }
+  String getFullVersion() { return String("host"); }
+  String getSdkVersion() { return String("host"); }
+  const char *getCoreVersion() { return "host"; }
+};
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,188 @@
+// Roc-MQTT-Display HOST BUILD - ArduinoJson
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// The subset of ArduinoJson 7 the sketch needs for its files: flat objects of strings, numbers and booleans.
+// Nested objects and arrays are skipped when reading and dropped when writing (status and metrics output only).
+
+#ifndef ARDUINOJSON_H
+#define ARDUINOJSON_H
+#include <Arduino.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct HostJsonValue {
+  enum Type { NONE, INTEGER, REAL, TEXT, BOOLEAN } type = NONE;
+  long long   i = 0;
+  double      d = 0;
+  std::string s;
+};
+
+class JsonDocument;
+class JsonObject;
+class JsonArray;
+
+class JsonVariant {
+public:
+  JsonVariant() {}
+  JsonVariant(JsonDocument *doc, const std::string &key) : doc(doc), key(key) {}
+
+  template <class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  T operator|(T def) const {
+    const HostJsonValue *v = value();
+    if (v == nullptr) return def;
+    switch (v->type){
+      case HostJsonValue::INTEGER: return (T)v->i;
+      case HostJsonValue::REAL:    return (T)v->d;
+      case HostJsonValue::BOOLEAN: return std::is_same<T, bool>::value ? (T)v->i : def;
+      default:                     return def;
+    }
+  }
+  const char *operator|(const char *def) const {
+    const HostJsonValue *v = value();
+    return (v != nullptr && v->type == HostJsonValue::TEXT) ? v->s.c_str() : def;
+  }
+  String operator|(const String &def) const { return String(*this | def.c_str()); }
+
+  template <class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  JsonVariant &operator=(T v) {
+    HostJsonValue *slot = create();
+    if (slot != nullptr){
+      if (std::is_same<T, bool>::value){ slot->type = HostJsonValue::BOOLEAN; slot->i = v; }
+      else if (std::is_floating_point<T>::value){ slot->type = HostJsonValue::REAL; slot->d = v; }
+      else { slot->type = HostJsonValue::INTEGER; slot->i = (long long)v; }
+    }
+    return *this;
+  }
+  JsonVariant &operator=(const char *v) {
+    HostJsonValue *slot = create();
+    if (slot != nullptr){ slot->type = HostJsonValue::TEXT; slot->s = (v != nullptr) ? v : ""; }
+    return *this;
+  }
+  JsonVariant &operator=(char *v) { return *this = (const char *)v; }
+  JsonVariant &operator=(const String &v) { return *this = v.c_str(); }
+  JsonVariant &operator=(const __FlashStringHelper *v) { return *this = (const char *)v; }
+  JsonVariant &operator=(const JsonVariant &) { return *this; }
+  JsonVariant &operator=(const JsonObject &) { return *this; }
+  JsonVariant &operator=(const JsonArray &) { return *this; }
+
+  JsonVariant operator[](const char *) const { return JsonVariant(); }
+  JsonVariant operator[](const String &) const { return JsonVariant(); }
+  JsonVariant operator[](int) const { return JsonVariant(); }
+
+  template <class T> T as() const;
+  template <class T> bool is() const;
+  bool isNull() const { return value() == nullptr; }
+  size_t size() const { return 0; }
+  template <class T> T to();
+  template <class T> T add();
+  template <class T> bool add(const T &) { return true; }
+  operator const char *() const { return *this | (const char *)nullptr; }
+
+private:
+  const HostJsonValue *value() const;
+  HostJsonValue *create();
+  JsonDocument *doc = nullptr;     // nullptr for nested members, they are not stored
+  std::string   key;
+};
+
+class JsonObject {
+public:
+  JsonVariant operator[](const char *) const { return JsonVariant(); }
+  JsonVariant operator[](const String &) const { return JsonVariant(); }
+  size_t size() const { return 0; }
+  bool isNull() const { return true; }
+};
+
+class JsonArray {
+public:
+  template <class T> bool add(const T &) { return true; }
+  template <class T> T add() { return T(); }
+  JsonVariant operator[](int) const { return JsonVariant(); }
+  size_t size() const { return 0; }
+  bool isNull() const { return true; }
+};
+
+class JsonDocument {
+public:
+  JsonDocument() {}
+  explicit JsonDocument(size_t) {}
+  JsonVariant operator[](const char *key) { return JsonVariant(this, key); }
+  JsonVariant operator[](const String &key) { return JsonVariant(this, key.c_str()); }
+  template <class T> T to() { members.clear(); return T(); }
+  void clear() { members.clear(); }
+  bool overflowed() const { return false; }
+  size_t memoryUsage() const { return members.size() * 16; }
+  size_t size() const { return members.size(); }
+
+  const HostJsonValue *find(const std::string &key) const {
+    for (const auto &m : members){
+      if (m.first == key) return &m.second;
+    }
+    return nullptr;
+  }
+  HostJsonValue *slot(const std::string &key) {
+    for (auto &m : members){
+      if (m.first == key) return &m.second;
+    }
+    members.push_back(std::make_pair(key, HostJsonValue()));
+    return &members.back().second;
+  }
+  std::vector<std::pair<std::string, HostJsonValue>> members;
+};
+
+inline const HostJsonValue *JsonVariant::value() const { return (doc != nullptr) ? doc->find(key) : nullptr; }
+inline HostJsonValue *JsonVariant::create() { return (doc != nullptr) ? doc->slot(key) : nullptr; }
+
+template <class T> inline T JsonVariant::as() const { return *this | T(); }
+template <> inline const char *JsonVariant::as<const char *>() const { return *this | (const char *)nullptr; }
+template <> inline String JsonVariant::as<String>() const { return String(*this | ""); }
+template <> inline JsonObject JsonVariant::as<JsonObject>() const { return JsonObject(); }
+template <> inline JsonArray JsonVariant::as<JsonArray>() const { return JsonArray(); }
+template <class T> inline bool JsonVariant::is() const {
+  const HostJsonValue *v = value();
+  if (v == nullptr) return false;
+  if (std::is_same<T, bool>::value) return v->type == HostJsonValue::BOOLEAN;
+  if (std::is_integral<T>::value) return v->type == HostJsonValue::INTEGER;
+  if (std::is_floating_point<T>::value) return v->type == HostJsonValue::INTEGER || v->type == HostJsonValue::REAL;
+  return v->type == HostJsonValue::TEXT;
+}
+template <class T> inline T JsonVariant::to() { return T(); }
+template <class T> inline T JsonVariant::add() { return T(); }
+
+
+class DeserializationError {
+public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput };
+  DeserializationError(Code c = Ok) : c(c) {}
+  explicit operator bool() const { return c != Ok; }
+  bool operator==(Code x) const { return c == x; }
+  bool operator!=(Code x) const { return c != x; }
+  Code code() const { return c; }
+  const char *c_str() const { return c == Ok ? "Ok" : c == EmptyInput ? "EmptyInput" : c == IncompleteInput ? "IncompleteInput" : "InvalidInput"; }
+  const char *f_str() const { return c_str(); }
+
+private:
+  Code c;
+};
+
+DeserializationError hostJsonParse(JsonDocument &doc, const char *s, size_t len);
+std::string hostJsonText(const JsonDocument &doc);
+
+inline DeserializationError deserializeJson(JsonDocument &doc, const char *s, size_t len) { return hostJsonParse(doc, s, len); }
+inline DeserializationError deserializeJson(JsonDocument &doc, const char *s) { return hostJsonParse(doc, s, strlen(s)); }
+inline DeserializationError deserializeJson(JsonDocument &doc, char *s) { return hostJsonParse(doc, s, strlen(s)); }
+inline DeserializationError deserializeJson(JsonDocument &doc, const uint8_t *s, size_t len) { return hostJsonParse(doc, (const char *)s, len); }
+inline DeserializationError deserializeJson(JsonDocument &doc, const String &s) { return hostJsonParse(doc, s.c_str(), s.length()); }
+inline DeserializationError deserializeJson(JsonDocument &doc, Stream &in) { String s = in.readString(); return hostJsonParse(doc, s.c_str(), s.length()); }
+
+inline size_t serializeJson(const JsonDocument &doc, Print &out) { std::string s = hostJsonText(doc); return out.write((const uint8_t *)s.data(), s.size()); }
+inline size_t serializeJson(const JsonDocument &doc, String &out) { out = String(hostJsonText(doc)); return out.length(); }
+inline size_t serializeJson(const JsonDocument &doc, char *out, size_t size) { std::string s = hostJsonText(doc); return size > 0 ? strlcpy(out, s.c_str(), size) : 0; }
+inline size_t serializeJsonPretty(const JsonDocument &doc, Print &out) { return serializeJson(doc, out); }
+inline size_t serializeJsonPretty(const JsonDocument &doc, String &out) { return serializeJson(doc, out); }
+inline size_t measureJson(const JsonDocument &doc) { return hostJsonText(doc).size(); }
+
+#endif
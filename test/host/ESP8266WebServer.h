@@ -0,0 +1,80 @@
+// Roc-MQTT-Display HOST BUILD - web server
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Handlers are registered and can be called by the render harness with the arguments it sets, responses go to hostHttp.
+
+#ifndef ESP8266WEBSERVER_H
+#define ESP8266WEBSERVER_H
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#include <map>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+
+struct HTTPUpload {
+  HTTPUploadStatus status;
+  String  filename;
+  String  name;
+  String  type;
+  size_t  totalSize;
+  size_t  currentSize;
+  uint8_t buf[2048];
+};
+
+typedef std::function<void()> HostHandler;
+
+class ESP8266WebServer {
+public:
+  ESP8266WebServer(int port = 80) { (void)port; hostServer = this; }
+  void on(const char *uri, HostHandler fn) { handlers[uri] = fn; }
+  void on(const char *uri, HTTPMethod, HostHandler fn) { handlers[uri] = fn; }
+  void on(const char *uri, HTTPMethod, HostHandler fn, HostHandler) { handlers[uri] = fn; }
+  void onNotFound(HostHandler) {}
+  void begin() {}
+  void close() {}
+  void handleClient() {}
+
+  void send(int code) { response(code, "", ""); }
+  void send(int code, const char *type, const String &content) { response(code, type, content.c_str()); }
+  void send(int code, const char *type, const char *content) { response(code, type, content); }
+  void send(int code, const char *type, const char *content, size_t len) { response(code, type, std::string(content, len).c_str()); }
+  void send_P(int code, PGM_P type, PGM_P content) { response(code, type, content); }
+  void send_P(int code, PGM_P type, PGM_P content, size_t len) { send(code, type, content, len); }
+  void setContentLength(size_t) {}
+  void sendHeader(const String &, const String &, bool = false) {}
+  void sendContent(const String &content) { body += content.s; }
+  void sendContent(const char *content) { body += content; }
+  void sendContent(const char *content, size_t len) { body.append(content, len); }
+  void sendContent_P(PGM_P content) { body += content; }
+  void sendContent_P(PGM_P content, size_t len) { body.append(content, len); }
+  template <class F> size_t streamFile(F &file, const String &type) { code = 200; (void)type; String s = file.readString(); body += s.s; return s.length(); }
+
+  int args() { return (int)arguments.size(); }
+  String argName(int k) { auto it = arguments.begin(); std::advance(it, k); return String(it->first); }
+  String arg(int k) { auto it = arguments.begin(); std::advance(it, k); return String(it->second); }
+  String arg(const String &name) { auto it = arguments.find(name.s); return (it != arguments.end()) ? String(it->second) : String(); }
+  bool hasArg(const String &name) { return arguments.count(name.s) > 0; }
+  String uri() { return String(path); }
+  HTTPMethod method() { return HTTP_GET; }
+  HTTPUpload &upload() { return uploadState; }
+
+  // Harness side
+  bool request(const char *uri, const std::map<std::string, std::string> &args);
+  std::map<std::string, HostHandler> handlers;
+  std::map<std::string, std::string> arguments;
+  std::string path;
+  std::string body;
+  int         code = 0;
+  static ESP8266WebServer *hostServer;
+
+private:
+  void response(int c, const char *, const char *content) { code = c; body += content; }
+  HTTPUpload uploadState;
+};
+
+#endif
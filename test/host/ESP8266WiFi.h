@@ -0,0 +1,29 @@
+// Roc-MQTT-Display HOST BUILD - WiFi
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef ESP8266WIFI_H
+#define ESP8266WIFI_H
+#include <Arduino.h>
+
+#define WL_CONNECTED 3
+
+class WiFiClass {
+public:
+  IPAddress localIP() { return IPAddress(); }
+  String macAddress() { return String("02:00:00:00:00:01"); }
+  String SSID() { return String("host"); }
+  String hostname() { return String("host"); }
+  int8_t RSSI() { return -50; }
+  uint8_t status() { return WL_CONNECTED; }
+  bool isConnected() { return true; }
+  void mode(int) {}
+  void disconnect(bool = false) {}
+};
+extern WiFiClass WiFi;
+
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+void configTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+
+#endif
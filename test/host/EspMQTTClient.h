@@ -0,0 +1,99 @@
+// Roc-MQTT-Display HOST BUILD - MQTT client
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Always connected client with a local broker: published messages are delivered to the matching subscriptions
+// on the next loop(), like the echo of a real broker. The first loop() calls onConnectionEstablished().
+
+#ifndef ESPMQTTCLIENT_H
+#define ESPMQTTCLIENT_H
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <functional>
+#include <deque>
+#include <vector>
+
+typedef std::function<void(const String &message)> MessageReceivedCallback;
+typedef std::function<void(const String &topicStr, const String &message)> MessageReceivedCallbackWithTopic;
+typedef std::function<void()> ConnectionEstablishedCallback;
+
+void onConnectionEstablished();
+
+class EspMQTTClient {
+public:
+  EspMQTTClient(const char *wifiSsid, const char *wifiPassword, const char *mqttServerIp, const char *mqttUsername,
+                const char *mqttPassword, const char *mqttClientName = "ESP8266", uint16_t mqttServerPort = 1883);
+  void enableDebuggingMessages(bool = true) {}
+  void enableHTTPWebUpdater(const char * = "/") {}
+  void enableOTA(const char * = nullptr, uint16_t = 0) {}
+  void enableLastWillMessage(const char *, const char *, bool = false) {}
+  bool setMaxPacketSize(uint16_t size) { maxPacket = size; return true; }
+  void setKeepAlive(uint16_t) {}
+  void setMqttReconnectionAttemptDelay(unsigned int) {}
+  void setWifiReconnectionAttemptDelay(unsigned int) {}
+  void setMqttClientName(const char *) {}
+  void setMqttServer(const char *, const char * = "", const char * = "", uint16_t = 1883) {}
+  void setWifiCredentials(const char *, const char *) {}
+
+  bool subscribe(const String &topic, MessageReceivedCallback cb, uint8_t qos = 0);
+  bool subscribe(const String &topic, MessageReceivedCallbackWithTopic cb, uint8_t qos = 0);
+  bool unsubscribe(const String &topic);
+  bool publish(const String &topic, const String &payload, bool retain = false);
+  void loop();
+
+  bool isConnected() const { return true; }
+  bool isWifiConnected() const { return true; }
+  bool isMqttConnected() const { return true; }
+  unsigned int getConnectionEstablishedCount() const { return connected ? 1 : 0; }
+
+  // Harness side
+  void deliver(const String &topic, const String &payload);
+  struct Subscription {
+    String topic;
+    MessageReceivedCallback cb;
+    MessageReceivedCallbackWithTopic cbTopic;
+  };
+  std::vector<Subscription> subscriptions;
+  std::deque<std::pair<String, String>> pending;
+  std::vector<std::pair<String, String>> published;
+  std::vector<std::pair<String, String>> received;     // delivered, not dropped for their size
+  uint16_t maxPacket = 128;
+  bool connected = false;
+  static EspMQTTClient *hostClient;
+};
+
+
+// OTA and Update of the ESP8266 core, never used on the host
+#define U_FLASH 0
+#define U_FS    100
+typedef enum { OTA_AUTH_ERROR, OTA_BEGIN_ERROR, OTA_CONNECT_ERROR, OTA_RECEIVE_ERROR, OTA_END_ERROR } ota_error_t;
+
+class ArduinoOTAClass {
+public:
+  void setPort(uint16_t) {}
+  void setHostname(const char *) {}
+  void setPassword(const char *) {}
+  void setPasswordHash(const char *) {}
+  void onStart(std::function<void()>) {}
+  void onEnd(std::function<void()>) {}
+  void onProgress(std::function<void(unsigned int, unsigned int)>) {}
+  void onError(std::function<void(ota_error_t)>) {}
+  int getCommand() { return U_FLASH; }
+  void begin(bool = true) {}
+  void handle() {}
+};
+extern ArduinoOTAClass ArduinoOTA;
+
+class UpdateClass {
+public:
+  bool begin(size_t, int = U_FLASH) { return false; }
+  size_t write(uint8_t *, size_t len) { return len; }
+  bool end(bool = false) { return false; }
+  bool hasError() { return true; }
+  void printError(Print &out) { out.println(F("Update not supported on the host")); }
+  void runAsync(bool) {}
+};
+extern UpdateClass Update;
+
+#endif
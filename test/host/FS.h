@@ -0,0 +1,66 @@
+// Roc-MQTT-Display HOST BUILD - file system
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// LittleFS in memory, directories are implied by the paths of the files
+
+#ifndef FS_H
+#define FS_H
+#include <Arduino.h>
+#include <map>
+#include <memory>
+
+typedef std::map<std::string, std::string> HostFiles;
+
+class File : public Stream {
+public:
+  File() {}
+  File(HostFiles *files, const std::string &path, bool write, bool dir);
+  operator bool() const { return files != nullptr; }
+  void close() { files = nullptr; }
+  const char *name() const { return path.c_str(); }
+  bool isDirectory() const { return dir; }
+  File openNextFile();
+  size_t size() const;
+  size_t position() const { return pos; }
+  bool seek(uint32_t p);
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t *buf, size_t size);
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  using Print::write;
+
+private:
+  std::string *data() const;
+  HostFiles  *files = nullptr;
+  std::string path;
+  bool        writing = false;
+  bool        dir = false;
+  size_t      pos = 0;
+  std::string next;                // directory, last file returned by openNextFile
+};
+
+class FS {
+public:
+  bool begin() { return true; }
+  void end() {}
+  File open(const char *path, const char *mode);
+  File open(const String &path, const char *mode) { return open(path.c_str(), mode); }
+  bool exists(const char *path);
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path) { return files.erase(path) > 0; }
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool format() { files.clear(); return true; }
+  HostFiles files;
+};
+
+namespace fs {
+  using ::File;
+  using ::FS;
+}
+
+#endif
@@ -0,0 +1,12 @@
+// Roc-MQTT-Display HOST BUILD - file system
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+#include <FS.h>
+
+extern FS LittleFS;
+
+#endif
@@ -0,0 +1,76 @@
+// Roc-MQTT-Display HOST BUILD - TaskScheduler
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Cooperative scheduler with the timing of TaskScheduler: an enabled task runs at once, then every interval after its
+// previous scheduled start. Tasks run in the order they were created.
+
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+#include <Arduino.h>
+#include <vector>
+
+#define TASK_IMMEDIATE   0
+#define TASK_FOREVER     (-1)
+#define TASK_ONCE        1
+#define TASK_MILLISECOND 1UL
+#define TASK_SECOND      1000UL
+#define TASK_MINUTE      60000UL
+
+class Scheduler;
+typedef void (*TaskCallback)();
+
+class Task {
+public:
+  Task(unsigned long interval = 0, long iterations = 0, TaskCallback cb = nullptr, Scheduler *s = nullptr, bool enable = false,
+       bool (*onEnable)() = nullptr, void (*onDisable)() = nullptr);
+
+  bool enable() { return enableDelayed(0); }
+  bool enableIfNot() { return enabled ? true : enable(); }
+  bool enableDelayed(unsigned long delay) { enabled = true; runs = 0; remaining = iterations; previous = millis() - interval + delay; return true; }
+  bool disable() { bool was = enabled; enabled = false; return was; }
+  bool isEnabled() const { return enabled; }
+  bool restart() { return enable(); }
+  bool restartDelayed(unsigned long delay = 0) { return enableDelayed(delay); }
+  void delay(unsigned long delay = 0) { previous = millis() - interval + (delay == 0 ? interval : delay); }
+  void forceNextIteration() { previous = millis() - interval; }
+  void set(unsigned long i, long it, TaskCallback cb) { interval = i; iterations = it; callback = cb; }
+  void setInterval(unsigned long i) { interval = i; delay(); }
+  unsigned long getInterval() const { return interval; }
+  void setIterations(long it) { iterations = remaining = it; }
+  long getIterations() const { return remaining; }
+  void setCallback(TaskCallback cb) { callback = cb; }
+  unsigned long getRunCounter() const { return runs; }
+  bool isFirstIteration() const { return runs <= 1; }
+  bool isLastIteration() const { return remaining == 0; }
+  long getOverrun() const { return overrun; }
+  unsigned long getStartDelay() const { return startDelay; }
+
+  bool run(unsigned long now);     // runs the task if it is due, true if it ran
+
+private:
+  unsigned long interval;
+  long          iterations;
+  long          remaining = 0;
+  TaskCallback  callback;
+  bool          enabled = false;
+  unsigned long previous = 0;      // scheduled start of the previous run
+  unsigned long runs = 0;
+  long          overrun = 0;
+  unsigned long startDelay = 0;
+};
+
+class Scheduler {
+public:
+  void init() {}
+  void addTask(Task &t) { tasks.push_back(&t); }
+  void deleteTask(Task &t);
+  bool execute();
+  void startNow() {}
+
+private:
+  std::vector<Task *> tasks;
+};
+
+#endif
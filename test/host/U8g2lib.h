@@ -0,0 +1,207 @@
+// Roc-MQTT-Display HOST BUILD - U8g2 frame buffer simulation
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Full frame buffer in the U8g2 layout of SSD13xx controllers: tile rows of 8 pixel rows, one byte per column, LSB = top pixel.
+// Transfers go into the RAM of the panel selected at the TCA9548A (see Wire.h), so frames of all displays can be compared.
+// Fonts are synthetic: every glyph is a deterministic pattern in a cell of the font's advance, ascent and descent.
+// Pixel output matches the sketch version under test against another version, not a real font, see test/golden/README.md.
+
+#ifndef U8G2LIB_H
+#define U8G2LIB_H
+#include <Arduino.h>
+
+typedef uint16_t u8g2_uint_t;
+typedef int16_t  u8g2_int_t;
+
+struct u8g2_cb_t { uint8_t rotation; };
+extern const u8g2_cb_t *U8G2_R0;
+extern const u8g2_cb_t *U8G2_R2;
+#define U8X8_PIN_NONE 255
+
+struct u8x8_t;
+typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+#define U8X8_MSG_BYTE_SEND           23
+#define U8X8_MSG_BYTE_INIT           24
+#define U8X8_MSG_BYTE_SET_DC         32
+#define U8X8_MSG_BYTE_START_TRANSFER 40
+#define U8X8_MSG_BYTE_END_TRANSFER   41
+
+struct u8x8_display_info_t {
+  uint8_t default_x_offset;
+  uint8_t flipmode_x_offset;
+  uint8_t tile_width;
+  uint8_t tile_height;
+};
+struct u8x8_t {
+  const u8x8_display_info_t *display_info;
+  u8x8_msg_cb byte_cb;
+  uint8_t x_offset;
+  uint8_t i2c_address;
+};
+struct u8g2_t {
+  u8x8_t u8x8;
+  uint8_t *tile_buf_ptr;
+  uint8_t tile_buf_height;
+  uint8_t tile_curr_row;
+};
+
+extern "C" {
+uint8_t u8x8_cad_StartTransfer(u8x8_t *u8x8);
+uint8_t u8x8_cad_SendCmd(u8x8_t *u8x8, uint8_t cmd);
+uint8_t u8x8_cad_SendArg(u8x8_t *u8x8, uint8_t arg);
+uint8_t u8x8_cad_EndTransfer(u8x8_t *u8x8);
+}
+
+// Synthetic fonts, data = advance, ascent, -descent, font number
+#define HOSTFONT(name) extern const uint8_t name[];
+HOSTFONT(u8g2_font_5x7_tf)
+HOSTFONT(u8g2_font_6x10_tf)
+HOSTFONT(u8g2_font_7x13_tf)
+HOSTFONT(u8g2_font_9x15_tf)
+HOSTFONT(u8g2_font_crox1hb_tf)
+HOSTFONT(u8g2_font_crox3hb_tf)
+HOSTFONT(u8g2_font_crox4hb_tf)
+HOSTFONT(u8g2_font_fur17_tf)
+HOSTFONT(u8g2_font_helvR08_tf)
+HOSTFONT(u8g2_font_rosencrantz_nbp_tf)
+
+
+// Display RAM and controller state of a panel behind the multiplexer
+#define HOSTPANELS 16
+struct HostPanel {
+  uint8_t  ram[132 * 8];           // 132 columns, 8 pages like the SSD1306
+  uint8_t  width;                  // pixel
+  uint8_t  height;
+  uint8_t  contrast;
+  bool     flip;
+  bool     invert;
+  bool     powerSave;
+  uint32_t transfers;              // full frames and areas sent to the panel
+  uint32_t bytes;                  // frame buffer bytes sent to the panel
+};
+extern HostPanel hostPanel[HOSTPANELS];
+extern int8_t hostMuxPort;         // panel selected at the multiplexer, -1 = none
+
+// U8g2 calls of the sketch, see render --cost
+struct HostCalls {
+  uint32_t glyphs;                 // glyphs drawn, including spaces
+  uint32_t widths;                 // text widths measured
+  uint32_t fonts;                  // fonts set
+};
+extern HostCalls hostCalls;
+
+
+class U8G2 : public Print {
+public:
+  U8G2(uint8_t width, uint8_t height, uint8_t xOffset, uint8_t flipXOffset);
+  virtual ~U8G2();
+
+  u8g2_t *getU8g2() { return &u8g2; }
+  u8x8_t *getU8x8() { return &u8g2.u8x8; }
+
+  bool begin();
+  void initDisplay();
+  void clearDisplay();
+  void setPowerSave(uint8_t is_enable);
+  void setFlipMode(uint8_t mode);
+  void setContrast(uint8_t value);
+  void setBusClock(uint32_t) {}
+  void setI2CAddress(uint8_t adr) { u8g2.u8x8.i2c_address = adr; }
+  void sendF(const char *fmt, ...);
+
+  u8g2_uint_t getDisplayWidth() const { return width; }
+  u8g2_uint_t getDisplayHeight() const { return height; }
+  uint8_t *getBufferPtr() { return buffer; }
+  uint8_t getBufferTileWidth() const { return width / 8; }
+  uint8_t getBufferTileHeight() const { return height / 8; }
+  uint8_t getBufferCurrTileRow() const { return u8g2.tile_curr_row; }
+  void setBufferCurrTileRow(uint8_t row) { u8g2.tile_curr_row = row; }
+
+  void clearBuffer();
+  void sendBuffer();
+  void firstPage();
+  uint8_t nextPage();
+  void updateDisplay();
+  void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+  void writeBufferXBM(Print &p);
+  void writeBufferPBM(Print &p);
+
+  void setDrawColor(uint8_t color) { drawColor = color; }
+  uint8_t getDrawColor() const { return drawColor; }
+  void setFontMode(uint8_t mode) { fontTransparent = (mode != 0); }
+  void setBitmapMode(uint8_t mode) { bitmapTransparent = (mode != 0); }
+  void setFont(const uint8_t *f) { font = f; hostCalls.fonts++; }
+  void setFontPosBaseline() {}
+  void enableUTF8Print() { utf8Print = true; }
+  void disableUTF8Print() { utf8Print = false; }
+  void setCursor(u8g2_uint_t x, u8g2_uint_t y) { tx = x; ty = y; }
+  u8g2_uint_t getCursorX() const { return tx; }
+  u8g2_uint_t getCursorY() const { return ty; }
+
+  int8_t getAscent() const { return font[1]; }
+  int8_t getDescent() const { return -(int8_t)font[2]; }
+  int8_t getMaxCharHeight() const { return font[1] + font[2]; }
+  int8_t getMaxCharWidth() const { return font[0]; }
+  u8g2_uint_t getUTF8Width(const char *s);
+  u8g2_uint_t getStrWidth(const char *s);
+
+  void drawPixel(u8g2_uint_t x, u8g2_uint_t y);
+  void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w);
+  void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h);
+  void drawLine(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1);
+  void drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+  void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+  void drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+  void drawXBMP(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap) { drawXBM(x, y, w, h, bitmap); }
+  u8g2_uint_t drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+  u8g2_uint_t drawStr(u8g2_uint_t x, u8g2_uint_t y, const char *s);
+  u8g2_uint_t drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char *s);
+  void setClipWindow(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1);
+  void setMaxClipWindow();
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  u8g2_t u8g2;
+
+private:
+  void pixel(int x, int y, uint8_t color);
+  void transfer(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+  bool decode(uint8_t c, uint16_t &e);
+
+  uint8_t  width;
+  uint8_t  height;
+  uint8_t *buffer;
+  u8x8_display_info_t info;
+  uint8_t  drawColor = 1;
+  bool     fontTransparent = false;
+  bool     bitmapTransparent = false;
+  bool     utf8Print = false;
+  const uint8_t *font;
+  u8g2_uint_t tx = 0;
+  u8g2_uint_t ty = 0;
+  int      clipX0 = 0;
+  int      clipY0 = 0;
+  int      clipX1 = 0;
+  int      clipY1 = 0;
+  uint8_t  utf8State = 0;
+  uint16_t utf8Code = 0;
+};
+
+// Full buffer constructors of the displays in the sketch
+#define HOSTDISPLAY(name, w, h, xo, fxo) \
+  class name : public U8G2 { \
+  public: \
+    name(const u8g2_cb_t *, uint8_t = U8X8_PIN_NONE, uint8_t = U8X8_PIN_NONE, uint8_t = U8X8_PIN_NONE) : U8G2(w, h, xo, fxo) {} \
+  };
+HOSTDISPLAY(U8G2_SSD1306_128X32_UNIVISION_F_HW_I2C, 128, 32, 0, 0)
+HOSTDISPLAY(U8G2_SSD1316_128X32_F_HW_I2C, 128, 32, 0, 0)
+HOSTDISPLAY(U8G2_SSD1306_128X64_NONAME_F_HW_I2C, 128, 64, 0, 0)
+HOSTDISPLAY(U8G2_SSD1306_64X48_ER_F_HW_I2C, 64, 48, 32, 32)
+HOSTDISPLAY(U8G2_SSD1306_96X16_ER_F_HW_I2C, 96, 16, 0, 32)
+HOSTDISPLAY(U8G2_SSD1306_72X40_ER_F_HW_I2C, 72, 40, 28, 28)
+HOSTDISPLAY(U8G2_SSD1306_64X32_NONAME_F_HW_I2C, 64, 32, 32, 32)
+
+#endif
@@ -0,0 +1,33 @@
+// Roc-MQTT-Display HOST BUILD - I2C
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// I2C master that emulates two TCA9548A multiplexers at 0x70 and 0x71, the selected port is hostMuxPort (0-15, -1 = none).
+// Transfers to other addresses succeed without effect.
+
+#ifndef WIRE_H
+#define WIRE_H
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  void begin() {}
+  void begin(int, int) {}
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t addr) { address = addr; count = 0; }
+  size_t write(uint8_t b) { if (count < sizeof(data)) data[count] = b; count++; return 1; }
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+
+private:
+  uint8_t address = 0;
+  uint8_t data[8];
+  uint8_t count = 0;
+  uint8_t selected[2] = { 0, 0 };  // port bits of the multiplexers
+};
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,697 @@
+// Roc-MQTT-Display HOST BUILD - runtime
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WebServer.h>
+#include <EspMQTTClient.h>
+#include <LittleFS.h>
+#include <TaskScheduler.h>
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <chrono>
+#include "host.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+TwoWire Wire;
+FS LittleFS;
+ArduinoOTAClass ArduinoOTA;
+UpdateClass Update;
+EspMQTTClient *EspMQTTClient::hostClient = nullptr;
+ESP8266WebServer *ESP8266WebServer::hostServer = nullptr;
+
+static uint64_t hostUs = 0;        // simulated time since reset
+bool hostWallClock = false;
+bool hostSerialEcho = getenv("RMD_SERIAL") != nullptr;
+std::string hostSerialLog;
+uint32_t hostStrings = 0;
+
+
+// *** Time ***
+unsigned long millis()
+{
+  return (unsigned long)(hostUs / 1000);
+}
+
+
+// The simulated time stands still while the sketch runs, with hostWallClock the host clock is added
+unsigned long micros()
+{
+  if (hostWallClock){
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+    return (unsigned long)(hostUs + std::chrono::duration_cast<std::chrono::microseconds>(t).count());
+  }
+  return (unsigned long)hostUs;
+}
+
+
+void delay(unsigned long ms)
+{
+  hostUs += (uint64_t)ms * 1000;
+}
+
+
+void hostAdvance(unsigned long ms)
+{
+  hostUs += (uint64_t)ms * 1000;
+}
+
+
+void yield()
+{
+}
+
+
+time_t hostTime(time_t *t)
+{
+  time_t now = 1709294400 + (time_t)(hostUs / 1000000);
+  if (t != nullptr){
+    *t = now;
+  }
+  return now;
+}
+
+
+void configTzTime(const char *, const char *, const char *, const char *)
+{
+}
+
+
+void configTime(const char *, const char *, const char *, const char *)
+{
+}
+
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+
+void digitalWrite(uint8_t, uint8_t)
+{
+}
+
+
+// Deterministic, runs of the harness must give the same frames
+long random(long max)
+{
+  static uint32_t seed = 1;
+  seed = seed * 1103515245u + 12345u;
+  return (max > 0) ? (long)((seed >> 8) % (uint32_t)max) : 0;
+}
+
+
+long random(long min, long max)
+{
+  return min + random(max - min);
+}
+
+
+#if !defined(__GLIBC__) || __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  size_t len = strlen(src);
+  if (size > 0){
+    size_t n = (len < size - 1) ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+
+size_t strlcat(char *dst, const char *src, size_t size)
+{
+  size_t len = strnlen(dst, size);
+  if (len == size){
+    return len + strlen(src);
+  }
+  return len + strlcpy(dst + len, src, size - len);
+}
+#endif
+
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (hostSerialEcho){
+    putchar(c);
+  }
+  if (hostSerialLog.size() < 1000000){
+    hostSerialLog += (char)c;
+  }
+  return 1;
+}
+
+
+// *** I2C, TCA9548A at 0x70 (ports 0-7) and 0x71 (ports 8-15) ***
+uint8_t TwoWire::endTransmission(bool)
+{
+  if ((address == 0x70 || address == 0x71) && count == 1){
+    selected[address - 0x70] = data[0];
+    hostMuxPort = -1;
+    for (uint8_t m = 0; m < 2; m++){
+      for (uint8_t k = 0; k < 8; k++){
+        if (selected[m] & (1 << k)){
+          // Two selected ports would connect two panels with the same address
+          hostMuxPort = (hostMuxPort < 0) ? m * 8 + k : -1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+
+// *** Files ***
+File::File(HostFiles *files, const std::string &path, bool write, bool dir) : files(files), path(path), writing(write), dir(dir)
+{
+}
+
+
+std::string *File::data() const
+{
+  if (files == nullptr || dir){
+    return nullptr;
+  }
+  auto it = files->find(path);
+  return (it != files->end()) ? &it->second : nullptr;
+}
+
+
+size_t File::size() const
+{
+  std::string *d = data();
+  return (d != nullptr) ? d->size() : 0;
+}
+
+
+bool File::seek(uint32_t p)
+{
+  if (p > size()){
+    return false;
+  }
+  pos = p;
+  return true;
+}
+
+
+int File::available()
+{
+  return (int)(size() - pos);
+}
+
+
+int File::read()
+{
+  std::string *d = data();
+  return (d != nullptr && pos < d->size()) ? (uint8_t)(*d)[pos++] : -1;
+}
+
+
+int File::peek()
+{
+  std::string *d = data();
+  return (d != nullptr && pos < d->size()) ? (uint8_t)(*d)[pos] : -1;
+}
+
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+  std::string *d = data();
+  if (d == nullptr || pos >= d->size()){
+    return 0;
+  }
+  size_t n = std::min(size, d->size() - pos);
+  memcpy(buf, d->data() + pos, n);
+  pos += n;
+  return n;
+}
+
+
+size_t File::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+  std::string *d = data();
+  if (d == nullptr || !writing){
+    return 0;
+  }
+  d->replace(pos, std::min(size, d->size() - pos), (const char *)buf, size);
+  pos += size;
+  return size;
+}
+
+
+// Files of a directory in the order of their names
+File File::openNextFile()
+{
+  if (files == nullptr || !dir){
+    return File();
+  }
+  std::string prefix = path + "/";
+  for (auto it = files->upper_bound(next.empty() ? prefix : next); it != files->end(); ++it){
+    if (it->first.compare(0, prefix.size(), prefix) != 0){
+      break;
+    }
+    if (it->first.find('/', prefix.size()) == std::string::npos){
+      next = it->first;
+      return File(files, it->first, false, false);
+    }
+  }
+  return File();
+}
+
+
+File FS::open(const char *path, const char *mode)
+{
+  std::string p = path;
+  if (mode[0] == 'w'){
+    files[p].clear();
+    return File(&files, p, true, false);
+  }
+  if (mode[0] == 'a'){
+    File f(&files, p, true, false);
+    f.seek(files[p].size());
+    return f;
+  }
+  if (files.count(p) > 0){
+    return File(&files, p, false, false);
+  }
+  auto it = files.lower_bound(p + "/");
+  if (it != files.end() && it->first.compare(0, p.size() + 1, p + "/") == 0){
+    return File(&files, p, false, true);
+  }
+  return File();
+}
+
+
+bool FS::exists(const char *path)
+{
+  return open(path, "r");
+}
+
+
+bool FS::rename(const char *from, const char *to)
+{
+  auto it = files.find(from);
+  if (it == files.end()){
+    return false;
+  }
+  files[to] = it->second;
+  files.erase(from);
+  return true;
+}
+
+
+// *** JSON, flat objects ***
+static const char *jsonSkip(const char *s, const char *end)
+{
+  while (s < end && (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n')){
+    s++;
+  }
+  return s;
+}
+
+
+// String at s (after the quote), returns the end or nullptr
+static const char *jsonString(const char *s, const char *end, std::string &out)
+{
+  while (s < end && *s != '"'){
+    if (*s == '\\' && s + 1 < end){
+      s++;
+      switch (*s){
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'u': {
+          if (end - s < 5){
+            return nullptr;
+          }
+          unsigned c = strtoul(std::string(s + 1, 4).c_str(), nullptr, 16);
+          if (c < 0x80){
+            out += (char)c;
+          }
+          else if (c < 0x800){
+            out += (char)(0xC0 | c >> 6);
+            out += (char)(0x80 | (c & 0x3F));
+          }
+          else {
+            out += (char)(0xE0 | c >> 12);
+            out += (char)(0x80 | ((c >> 6) & 0x3F));
+            out += (char)(0x80 | (c & 0x3F));
+          }
+          s += 4;
+          break;
+        }
+        default: out += *s; break;
+      }
+      s++;
+    }
+    else {
+      out += *s++;
+    }
+  }
+  return (s < end) ? s + 1 : nullptr;
+}
+
+
+// Skip a nested object or array
+static const char *jsonNested(const char *s, const char *end)
+{
+  int depth = 0;
+  std::string ignore;
+  while (s < end){
+    if (*s == '"'){
+      s = jsonString(s + 1, end, ignore);
+      if (s == nullptr){
+        return nullptr;
+      }
+      continue;
+    }
+    if (*s == '{' || *s == '['){
+      depth++;
+    }
+    else if (*s == '}' || *s == ']'){
+      if (--depth == 0){
+        return s + 1;
+      }
+    }
+    s++;
+  }
+  return nullptr;
+}
+
+
+DeserializationError hostJsonParse(JsonDocument &doc, const char *s, size_t len)
+{
+  doc.clear();
+  const char *end = s + len;
+  s = jsonSkip(s, end);
+  if (s >= end || *s == '\0'){
+    return DeserializationError::EmptyInput;
+  }
+  if (*s != '{'){
+    return DeserializationError::InvalidInput;
+  }
+  s = jsonSkip(s + 1, end);
+  if (s < end && *s == '}'){
+    return DeserializationError::Ok;
+  }
+  while (s < end){
+    std::string key;
+    if (*s != '"' || (s = jsonString(s + 1, end, key)) == nullptr){
+      return DeserializationError::InvalidInput;
+    }
+    s = jsonSkip(s, end);
+    if (s >= end || *s != ':'){
+      return DeserializationError::IncompleteInput;
+    }
+    s = jsonSkip(s + 1, end);
+    if (s >= end){
+      return DeserializationError::IncompleteInput;
+    }
+    HostJsonValue v;
+    if (*s == '"'){
+      v.type = HostJsonValue::TEXT;
+      if ((s = jsonString(s + 1, end, v.s)) == nullptr){
+        return DeserializationError::IncompleteInput;
+      }
+    }
+    else if (*s == '{' || *s == '['){
+      if ((s = jsonNested(s, end)) == nullptr){
+        return DeserializationError::IncompleteInput;
+      }
+    }
+    else if (end - s >= 4 && memcmp(s, "true", 4) == 0){
+      v.type = HostJsonValue::BOOLEAN;
+      v.i = 1;
+      s += 4;
+    }
+    else if (end - s >= 5 && memcmp(s, "false", 5) == 0){
+      v.type = HostJsonValue::BOOLEAN;
+      s += 5;
+    }
+    else if (end - s >= 4 && memcmp(s, "null", 4) == 0){
+      s += 4;
+    }
+    else {
+      const char *n = s;
+      while (s < end && strchr("+-0123456789.eE", *s) != nullptr){
+        s++;
+      }
+      std::string num(n, s);
+      if (num.empty()){
+        return DeserializationError::InvalidInput;
+      }
+      if (num.find_first_of(".eE") != std::string::npos){
+        v.type = HostJsonValue::REAL;
+        v.d = atof(num.c_str());
+      }
+      else {
+        v.type = HostJsonValue::INTEGER;
+        v.i = atoll(num.c_str());
+      }
+    }
+    if (v.type != HostJsonValue::NONE){
+      *doc.slot(key) = v;
+    }
+    s = jsonSkip(s, end);
+    if (s < end && *s == ','){
+      s = jsonSkip(s + 1, end);
+      continue;
+    }
+    if (s < end && *s == '}'){
+      return DeserializationError::Ok;
+    }
+    return DeserializationError::IncompleteInput;
+  }
+  return DeserializationError::IncompleteInput;
+}
+
+
+static void jsonQuote(std::string &out, const std::string &s)
+{
+  out += '"';
+  for (char c : s){
+    if (c == '"' || c == '\\'){
+      out += '\\';
+      out += c;
+    }
+    else if ((uint8_t)c < 0x20){
+      char u[8];
+      snprintf(u, sizeof(u), "\\u%04x", c);
+      out += u;
+    }
+    else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+
+std::string hostJsonText(const JsonDocument &doc)
+{
+  std::string out = "{";
+  for (const auto &m : doc.members){
+    if (out.size() > 1){
+      out += ',';
+    }
+    jsonQuote(out, m.first);
+    out += ':';
+    const HostJsonValue &v = m.second;
+    char num[32];
+    switch (v.type){
+      case HostJsonValue::INTEGER: snprintf(num, sizeof(num), "%lld", v.i); out += num; break;
+      case HostJsonValue::REAL:    snprintf(num, sizeof(num), "%.9g", v.d); out += num; break;
+      case HostJsonValue::BOOLEAN: out += v.i ? "true" : "false"; break;
+      case HostJsonValue::TEXT:    jsonQuote(out, v.s); break;
+      default:                     out += "null"; break;
+    }
+  }
+  return out + "}";
+}
+
+
+// *** TaskScheduler ***
+Task::Task(unsigned long interval, long iterations, TaskCallback cb, Scheduler *s, bool enable, bool (*)(), void (*)())
+  : interval(interval), iterations(iterations), callback(cb)
+{
+  if (s != nullptr){
+    s->addTask(*this);
+  }
+  if (enable){
+    this->enable();
+  }
+}
+
+
+bool Task::run(unsigned long now)
+{
+  if (!enabled || callback == nullptr){
+    return false;
+  }
+  long late = (long)(now - previous - interval);
+  if (late < 0){
+    return false;
+  }
+  if (iterations >= 0 && remaining == 0){
+    enabled = false;
+    return false;
+  }
+  overrun = -late;
+  startDelay = late;
+  previous += interval;
+  runs++;
+  if (remaining > 0){
+    remaining--;
+  }
+  callback();
+  return true;
+}
+
+
+void Scheduler::deleteTask(Task &t)
+{
+  tasks.erase(std::remove(tasks.begin(), tasks.end(), &t), tasks.end());
+}
+
+
+bool Scheduler::execute()
+{
+  bool idle = true;
+  static std::vector<Task *> list;   // tasks may be added while running, the copy keeps its capacity
+  list = tasks;
+  for (Task *t : list){
+    if (t->run(millis())){
+      idle = false;
+    }
+  }
+  return idle;
+}
+
+
+// *** MQTT ***
+EspMQTTClient::EspMQTTClient(const char *, const char *, const char *, const char *, const char *, const char *, uint16_t)
+{
+  hostClient = this;
+}
+
+
+static bool topicMatch(const char *filter, const char *topic)
+{
+  for (; *filter != '\0'; filter++){
+    if (*filter == '#'){
+      return true;
+    }
+    if (*filter == '+'){
+      while (*topic != '\0' && *topic != '/'){
+        topic++;
+      }
+      continue;
+    }
+    if (*filter != *topic){
+      return false;
+    }
+    topic++;
+  }
+  return *topic == '\0';
+}
+
+
+bool EspMQTTClient::subscribe(const String &topic, MessageReceivedCallback cb, uint8_t)
+{
+  unsubscribe(topic);
+  subscriptions.push_back({ topic, cb, nullptr });
+  return true;
+}
+
+
+bool EspMQTTClient::subscribe(const String &topic, MessageReceivedCallbackWithTopic cb, uint8_t)
+{
+  unsubscribe(topic);
+  subscriptions.push_back({ topic, nullptr, cb });
+  return true;
+}
+
+
+bool EspMQTTClient::unsubscribe(const String &topic)
+{
+  for (auto it = subscriptions.begin(); it != subscriptions.end(); ++it){
+    if (it->topic == topic){
+      subscriptions.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool EspMQTTClient::publish(const String &topic, const String &payload, bool)
+{
+  published.push_back(std::make_pair(topic, payload));
+  pending.push_back(std::make_pair(topic, payload));
+  return true;
+}
+
+
+// Deliver a message like PubSubClient, messages that don't fit into the packet buffer are dropped:
+// topic + payload + 9 must stay below the packet size
+void EspMQTTClient::deliver(const String &topic, const String &payload)
+{
+  if (topic.length() + payload.length() + 9 >= maxPacket){
+    return;
+  }
+  received.push_back(std::make_pair(topic, payload));
+  std::vector<Subscription> list = subscriptions;
+  for (const Subscription &s : list){
+    if (topicMatch(s.topic.c_str(), topic.c_str())){
+      if (s.cb){
+        s.cb(payload);
+      }
+      else {
+        s.cbTopic(topic, payload);
+      }
+    }
+  }
+}
+
+
+void EspMQTTClient::loop()
+{
+  if (!connected){
+    connected = true;
+    onConnectionEstablished();
+  }
+  for (size_t n = pending.size(); n > 0 && !pending.empty(); n--){
+    std::pair<String, String> m = pending.front();
+    pending.pop_front();
+    deliver(m.first, m.second);
+  }
+}
+
+
+// *** Web server ***
+bool ESP8266WebServer::request(const char *uri, const std::map<std::string, std::string> &args)
+{
+  auto it = handlers.find(uri);
+  if (it == handlers.end()){
+    return false;
+  }
+  path = uri;
+  arguments = args;
+  body.clear();
+  code = 0;
+  it->second();
+  return true;
+}
@@ -0,0 +1,17 @@
+// Roc-MQTT-Display HOST BUILD - harness interface
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#ifndef HOST_H
+#define HOST_H
+#include <Arduino.h>
+#include <string>
+
+void hostAdvance(unsigned long ms);          // let the simulated time pass
+extern bool hostWallClock;                   // micros() reads the host clock, for draw times
+extern bool hostSerialEcho;                  // copy Serial output to stdout
+extern std::string hostSerialLog;            // Serial output so far
+extern uint32_t hostUnselected;              // display transfers without a panel selected at the multiplexer
+
+#endif
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# Roc-MQTT-Display HOST BUILD - sketch preprocessor
+# Version 1.13
+# Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+# https://github.com/chrisweather/RocMQTTdisplay
+#
+# Turns the sketch into a C++ file like the Arduino builder: Arduino.h first and prototypes of all
+# functions before the first function definition. time() is redirected to the simulated clock.
+# With a display class the constructor of the sketch is replaced by it, like selecting another one at the top of the sketch.
+#   ino2cpp.py RocMQTTdisplay.ino sketch.cpp [U8G2_SSD1306_128X64_NONAME_F_HW_I2C]
+
+import re
+import sys
+
+src = open(sys.argv[1], encoding='utf-8').read()
+
+# The global "tm tm;" hides the type for the prototypes
+src = re.sub(r'^tm tm;', 'struct tm tmNow;', src, flags=re.M)
+src = re.sub(r'\btm\.', 'tmNow.', src)
+src = src.replace('&tm)', '&tmNow)')
+src = re.sub(r'\btime\(&', 'hostTime(&', src)
+if len(sys.argv) > 3:
+    src, n = re.subn(r'^U8G2_\w+ disp\(', sys.argv[3] + ' disp(', src, flags=re.M)
+    if n != 1:
+        sys.exit('ino2cpp.py: no display constructor in %s' % sys.argv[1])
+
+protos = []
+first = None
+for m in re.finditer(r'^((?:static |inline )?(?:[A-Za-z_][\w:<>\*&]*\s+)+\**[A-Za-z_]\w*\s*\([^;{)]*\))\s*\n?\s*\{', src, re.M):
+    sig = m.group(1).strip()
+    if sig.split()[0] in ('if', 'while', 'for', 'switch', 'else', 'return', 'do'):
+        continue
+    sig = re.sub(r'\s*=\s*[^,)]+', '', sig)
+    protos.append(sig + ';')
+    if first is None:
+        first = m.start()
+
+out = src[:first] + '\n'.join(protos) + '\n#line %d "%s"\n' % (src.count('\n', 0, first) + 1, sys.argv[1]) + src[first:]
+with open(sys.argv[2], 'w', encoding='utf-8') as f:
+    f.write('#include <Arduino.h>\n#line 1 "%s"\n' % sys.argv[1] + out)
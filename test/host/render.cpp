@@ -0,0 +1,577 @@
+// Roc-MQTT-Display HOST BUILD - render harness
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Runs the sketch with the files of data/ on four simulated displays, sends one message per scenario and records the
+// frames every panel shows. One line per scenario and panel: number of distinct frames, CRC32 of the frame sequence
+// and CRC32 of the last frame (display RAM, contrast, flip, invert, power save).
+//   render              print the frames as CSV
+//   render golden.csv   compare with a recorded run, exit code 1 if a frame differs
+// With --bench the harness calls /bench instead and keeps the glyph count and frame CRC32 of every template and case.
+// The draw times are left out, the simulated clock stands still while the sketch draws. --times prints the whole
+// /bench CSV with draw times measured with the host clock, they vary between runs and hosts and aren't compared.
+// --xbm records the first frame of every template for the case msg as XBM image, as /bench?xbm=1 and printBuffer()
+// write it to Serial.
+//   render --bench [golden.csv]
+//   render --xbm [golden.txt]
+//   render --times [live=1]
+// --cost runs the scenarios and prints the display transfers, the U8g2 calls and the host time spent in loop() per
+// scenario, to compare the cost of drawing between builds, e.g. with an older SKETCH_DIR. Not compared either.
+//   render --cost
+// --clock shows the rail and NTP time on three of eight displays, the others show a train without variables. Prints per
+// second of NTP time and per Rocrail clock message the host time the sketch needs for it, the String objects
+// constructed, the heap allocations and the text widths measured. Not compared, like --cost.
+//   render --clock
+// --boot starts eight displays with the STARTDELAY of data/, fast with FASTBOOT=1, and sends the first message when
+// MQTT is connected. Prints the boot timeline of the root page, in simulated time: the delays of the start, the time
+// the sketch computes isn't included. Not compared.
+//   render --boot [fast]
+// --route runs the controller as router and sends batches for one display of growing size, every message has to
+// arrive in a routed payload the MQTT client takes. Exit code 1 if one is lost.
+//   render --route
+// The display is the constructor of the sketch, or the one ino2cpp.py put in, see CMakeLists.txt.
+// With RMD_FRAMES=dir the last frame of every scenario and panel is written to dir as PBM image.
+
+#include <ESP8266WebServer.h>
+#include <EspMQTTClient.h>
+#include <LittleFS.h>
+#include <U8g2lib.h>
+#include <dirent.h>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <vector>
+#include "host.h"
+
+void setup();
+void loop();
+
+#define PANELS  4                  // NUMDISP of the run
+#define RUNMS   3000               // ms per scenario
+
+static uint32_t heapAllocs = 0;   // operator new calls, see clockCost()
+
+
+void *operator new(size_t size)
+{
+  heapAllocs++;
+  void *p = malloc(size > 0 ? size : 1);
+  if (p == nullptr){
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+
+void operator delete(void *p, size_t) noexcept
+{
+  free(p);
+}
+
+
+struct Scenario {
+  const char *name;
+  const char *topic;               // nullptr = MQTT_TOPIC2
+  const char *payload;
+};
+
+// Every template with a scrolling and a short message, the variables, UTF-8, a track without station and unknown IDs.
+// Rocrail pads text messages with "...."
+static const Scenario scenarios[] = {
+  { "T0", nullptr, "ZZAMSG#D01D02D03D04#T0#Bhf01#4#Hamburg-Hbf#08:17#ICE 597#ICE#Abfahrt heute auf Gleis 4 - Vorsicht an der Bahnsteigkante###...." },
+  { "T1", nullptr, "ZZAMSG#D01D02D03D04#T1#Bhf01#4#Hamburg-Hbf#08:17#ICE 597#ICE#Abfahrt heute auf Gleis 4 - Vorsicht an der Bahnsteigkante###...." },
+  { "T2", nullptr, "ZZAMSG#D01D02D03D04#T2#Bhf01#5#Stellingen#16:43#S21#S####...." },
+  { "T3", nullptr, "ZZAMSG#D01D02D03D04#T3#Bhf01#5#Stellingen#16:43#S21#S#Zug faellt aus###...." },
+  { "T4", nullptr, "ZZAMSG#D01D02D03D04#T4#######Bitte nicht einsteigen###...." },
+  { "T5", nullptr, "ZZAMSG#D01D02D03D04#T5#######Zugdurchfahrt - Vorsicht an der Bahnsteigkante###...." },
+  { "T6", nullptr, "ZZAMSG#D01D02D03D04#T6#Gartenstadt#########...." },
+  { "T7", nullptr, "ZZAMSG#D01D02D03D04#T7#Bhf01#2#Wien Hbf#10:22#RJ 42#ÖBB#Verspätung ca. 5 Minuten###...." },
+  { "T8", nullptr, "ZZAMSG#D01D02D03D04#T8#Bhf01#3#Zürich HB#11:05#IC 8#SBB#Wagenreihung geändert###...." },
+  { "T9", nullptr, "ZZAMSG#D01D02D03D04#T9##2#####Ersatzfahrplan wg. Bahnstreik###...." },
+  { "rrtime", nullptr, "ZZAMSG#D01D02#T4#######{rrtime} Uhr###...." },
+  { "ntptime", nullptr, "ZZAMSG#D03D04#T4#######{ntpdate} {ntptime}###...." },
+  { "mixed", nullptr, "ZZAMSG#D02D04#T0#Köln Hbf#1#Köln-Bonn#10:22#RE7#RE#5min Verspätung - 5min delayed###...." },
+  { "track", nullptr, "ZZAMSG#D01#T0##7#Bremen#12:01#RB 41#RB####...." },
+  { "unknown", nullptr, "ZZAMSG#D09D1#T0#Bhf01#1#Nirgendwo#00:00#X#X#nicht angezeigt###...." },
+  { "clear", nullptr, "ZZAMSG#D01D02D03D04###########...." },
+};
+
+
+// CRC32 (IEEE)
+static uint32_t crc32(uint32_t crc, const uint8_t *p, size_t len)
+{
+  crc = ~crc;
+  while (len-- > 0){
+    crc ^= *p++;
+    for (uint8_t k = 0; k < 8; k++){
+      crc = (crc >> 1) ^ (0xEDB88320u & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+
+static uint32_t panelCrc(const HostPanel &p)
+{
+  uint8_t regs[4] = { p.contrast, p.flip, p.invert, p.powerSave };
+  return crc32(crc32(0, p.ram, sizeof(p.ram)), regs, sizeof(regs));
+}
+
+
+// Copy the files of data/ into the simulated LittleFS, with four displays of which two show side B or are flipped.
+// As router with --route, with eight displays with --clock and --boot, --boot with the root page and the delays of data/.
+static void loadFiles(const std::string &dir, const char *mode, bool fast)
+{
+  DIR *d = opendir(dir.c_str());
+  if (d == nullptr){
+    fprintf(stderr, "render: can't read %s\n", dir.c_str());
+    exit(2);
+  }
+  bool boot = (strcmp(mode, "--boot") == 0);
+  for (struct dirent *e = readdir(d); e != nullptr; e = readdir(d)){
+    std::string name = e->d_name;
+    if ((name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) && !(boot && name == "index.htm")){
+      continue;
+    }
+    std::ifstream in(dir + "/" + name, std::ios::binary);
+    std::stringstream text;
+    text << in.rdbuf();
+    std::string s = text.str();
+    if (name == "rmdcfg.txt"){
+      const char *edits[][2] = {
+        { "\"NUMDISP\":2", (strcmp(mode, "--clock") == 0 || boot) ? "\"NUMDISP\":8" : "\"NUMDISP\":4" },
+        { "\"DPL_SIDE1\":0", "\"DPL_SIDE1\":1" },
+        { "\"DPL_FLIP2\":0", "\"DPL_FLIP2\":1" },
+        { "\"DPL_CONTRAST3\":50", "\"DPL_CONTRAST3\":200" },
+        { "\"DPL_TRACK3\":1", "\"DPL_TRACK3\":4" },
+        { "\"STARTDELAY\":3000", boot ? "\"STARTDELAY\":3000" : "\"STARTDELAY\":500" },
+        { "\"MQTT_DEBUG\":0", (strcmp(mode, "--route") == 0) ? "\"MQTT_DEBUG\":0,\"MQTT_ROUTE\":3" : "\"MQTT_DEBUG\":0" },
+        { "\"SCREENSAVER\"", fast ? "\"FASTBOOT\":1,\"SCREENSAVER\"" : "\"SCREENSAVER\"" },
+      };
+      for (auto &x : edits){
+        size_t p = s.find(x[0]);
+        if (p != std::string::npos){
+          s.replace(p, strlen(x[0]), x[1]);
+        }
+      }
+    }
+    LittleFS.files["/" + name] = s;
+  }
+  closedir(d);
+}
+
+
+// Write the display RAM of panel k as PBM image
+static void dumpPanel(const char *dir, const char *scenario, uint8_t k)
+{
+  const HostPanel &p = hostPanel[k];
+  std::string name = std::string(dir) + "/" + scenario + "_" + std::to_string(k + 1) + ".pbm";
+  FILE *f = fopen(name.c_str(), "w");
+  if (f == nullptr){
+    return;
+  }
+  fprintf(f, "P1\n%u %u\n", p.width, p.height);
+  for (uint8_t y = 0; y < p.height; y++){
+    for (uint8_t x = 0; x < p.width; x++){
+      fputc((p.ram[(y / 8) * 132 + x] >> (y % 8)) & 1 ? '1' : '0', f);
+    }
+    fputc('\n', f);
+  }
+  fclose(f);
+}
+
+
+struct PanelRun {
+  uint32_t frames;
+  uint32_t seq;
+  uint32_t last;
+};
+
+
+static uint64_t loopNs = 0;        // host time spent in loop()
+
+
+// Run the sketch for ms milliseconds and record the distinct frames of every panel
+static void run(unsigned long ms, PanelRun *runs)
+{
+  for (uint8_t k = 0; k < PANELS; k++){
+    runs[k] = { 0, 0, panelCrc(hostPanel[k]) };
+  }
+  for (unsigned long t = 0; t < ms; t++){
+    auto t0 = std::chrono::steady_clock::now();
+    loop();
+    loopNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    hostAdvance(1);
+    for (uint8_t k = 0; k < PANELS; k++){
+      uint32_t c = panelCrc(hostPanel[k]);
+      if (c != runs[k].last){
+        runs[k].frames++;
+        runs[k].seq = crc32(runs[k].seq, (const uint8_t *)&c, sizeof(c));
+        runs[k].last = c;
+      }
+    }
+  }
+}
+
+
+// Start up, connect and set the railroad clock
+static void startUp(PanelRun *runs)
+{
+  run(2000, runs);
+  EspMQTTClient::hostClient->deliver("rocrail/service/info/clock", "<clock divider=\"1\" hour=\"18\" minute=\"40\" wday=\"5\" mday=\"12\" month=\"2\" year=\"2021\" time=\"1613151626\" cmd=\"sync\"/>");
+  run(1000, runs);
+}
+
+
+// Scenarios on all panels as CSV
+static std::string scenarioFrames()
+{
+  PanelRun runs[PANELS];
+  startUp(runs);
+  EspMQTTClient *client = EspMQTTClient::hostClient;
+
+  const char *dump = getenv("RMD_FRAMES");
+  std::string out = "scenario,panel,frames,sequence_crc,last_crc\n";
+  for (const Scenario &s : scenarios){
+    client->deliver(s.topic != nullptr ? s.topic : "rocrail/service/info/tx", s.payload);
+    run(RUNMS, runs);
+    for (uint8_t k = 0; k < PANELS; k++){
+      char line[96];
+      snprintf(line, sizeof(line), "%s,%u,%u,%08x,%08x\n", s.name, k + 1, runs[k].frames, runs[k].seq, runs[k].last);
+      out += line;
+      if (dump != nullptr){
+        dumpPanel(dump, s.name, k);
+      }
+    }
+  }
+  if (hostUnselected > 0){
+    char line[64];
+    snprintf(line, sizeof(line), "unselected,0,%u,0,0\n", hostUnselected);
+    out += line;
+  }
+  return out;
+}
+
+
+// Transfers to all panels, U8g2 calls and host time of loop() per scenario as CSV
+static std::string scenarioCost()
+{
+  PanelRun runs[PANELS];
+  startUp(runs);
+  std::string out = "scenario,transfers,glyphs,widths,fonts,loop_us\n";
+  for (const Scenario &s : scenarios){
+    EspMQTTClient::hostClient->deliver(s.topic != nullptr ? s.topic : "rocrail/service/info/tx", s.payload);
+    uint32_t transfers = 0;
+    for (uint8_t k = 0; k < PANELS; k++){
+      transfers -= hostPanel[k].transfers;
+    }
+    HostCalls calls = hostCalls;
+    loopNs = 0;
+    run(RUNMS, runs);
+    for (uint8_t k = 0; k < PANELS; k++){
+      transfers += hostPanel[k].transfers;
+    }
+    char line[128];
+    snprintf(line, sizeof(line), "%s,%u,%u,%u,%u,%u\n", s.name, transfers, hostCalls.glyphs - calls.glyphs,
+             hostCalls.widths - calls.widths, hostCalls.fonts - calls.fonts, (unsigned)(loopNs / 1000));
+    out += line;
+  }
+  return out;
+}
+
+
+// Eight displays, D01 and D02 show {rrtime}, D03 {ntpdate} {ntptime}. Two minutes of NTP time, then one Rocrail clock
+// message per second for two minutes. Per second and per message: host time of the message and the loop() calls of the
+// following CLOCKMS ms, String objects, heap allocations and text widths of the whole second, as CSV.
+#define CLOCKTICKS 120
+#define CLOCKMS    20
+static std::string clockCost()
+{
+  PanelRun runs[PANELS];
+  startUp(runs);
+  EspMQTTClient *client = EspMQTTClient::hostClient;
+  client->deliver("rocrail/service/info/tx", "ZZAMSG#D01D02#T4#######{rrtime} Uhr###....");
+  client->deliver("rocrail/service/info/tx", "ZZAMSG#D03#T4#######{ntpdate} {ntptime}###....");
+  client->deliver("rocrail/service/info/tx", "ZZAMSG#D04D05D06D07D08#T2#Bhf01#5#Stellingen#16:43#S21#S####....");
+  run(RUNMS, runs);
+
+  std::string out = "phase,count,tick_us,strings,heap_allocs,widths\n";
+  for (uint8_t phase = 0; phase < 2; phase++){
+    uint32_t strings = hostStrings, allocs = heapAllocs, widths = hostCalls.widths;
+    uint64_t tickNs = 0;
+    for (unsigned k = 0; k < CLOCKTICKS; k++){
+      loopNs = 0;
+      if (phase == 1){
+        char clock[192];
+        snprintf(clock, sizeof(clock), "<clock divider=\"1\" hour=\"%u\" minute=\"%u\" wday=\"5\" mday=\"12\" month=\"2\" year=\"2021\" time=\"1613151626\" cmd=\"sync\"/>", 19 + k / 60, k % 60);
+        auto t0 = std::chrono::steady_clock::now();
+        client->deliver("rocrail/service/info/clock", clock);
+        loopNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+      }
+      run(CLOCKMS, runs);
+      tickNs += loopNs;
+      run(1000 - CLOCKMS, runs);
+    }
+    char line[128];
+    snprintf(line, sizeof(line), "%s,%u,%.1f,%.1f,%.1f,%.1f\n", phase == 0 ? "ntp_second" : "clock_message", CLOCKTICKS,
+             tickNs / 1000.0 / CLOCKTICKS, (double)(hostStrings - strings) / CLOCKTICKS,
+             (double)(heapAllocs - allocs) / CLOCKTICKS, (double)(hostCalls.widths - widths) / CLOCKTICKS);
+    out += line;
+  }
+  return out;
+}
+
+
+// Boot timeline of the root page after the first message, "serial 0.50 s, ..." as CSV
+static std::string bootTimeline()
+{
+  PanelRun runs[PANELS];
+  run(1, runs);                    // connects MQTT
+  EspMQTTClient::hostClient->deliver("rocrail/service/info/tx", "ZZAMSG#D01D02D03D04D05D06D07D08#T2#Bhf01#5#Stellingen#16:43#S21#S####....");
+  run(RUNMS, runs);
+  ESP8266WebServer *server = ESP8266WebServer::hostServer;
+  if (!server->request("/", {}) || server->code != 200){
+    fprintf(stderr, "render: / failed\n");
+    exit(2);
+  }
+  const std::string head = "Boot: ";
+  size_t p = server->body.find(head);
+  size_t end = server->body.find("</p>", p);
+  if (p == std::string::npos || end == std::string::npos){
+    fprintf(stderr, "render: no boot timeline on /\n");
+    exit(2);
+  }
+  std::istringstream in(server->body.substr(p + head.size(), end - p - head.size()));
+  std::string out = "phase,seconds\n";
+  for (std::string phase; std::getline(in, phase, ',');){
+    phase.erase(0, phase.find_first_not_of(' '));
+    size_t s = phase.rfind(' ', phase.size() - 3);
+    out += phase.substr(0, s) + "," + phase.substr(s + 1, phase.size() - s - 3) + "\n";
+  }
+  return out;
+}
+
+
+// Router: batches of seven messages for display D01 on MQTT_TOPIC2, the last message one byte longer with every batch
+// until the batch itself is too large. ZZAMSG v2 takes more bytes per field than the text, so the routed payloads
+// reach the packet size and are split. Every message has to be received on rmd/display/D01, payloads at the limit too.
+#define ROUTEMSGS 7
+static bool routeCheck()
+{
+  PanelRun runs[PANELS];
+  startUp(runs);
+  EspMQTTClient *client = EspMQTTClient::hostClient;
+  const String topic = "rmd/display/D01";
+  bool ok = true;
+  unsigned atLimit = 0, split = 0;
+  for (unsigned len = 1; ; len++){
+    std::string batch = "ZZABATCH#";
+    std::vector<std::string> marks;
+    for (unsigned k = 0; k < ROUTEMSGS; k++){
+      char mark[16];
+      snprintf(mark, sizeof(mark), "M%03u_%u", len, k);   // same length for all batches
+      marks.push_back(mark);
+      std::string msg = marks.back() + (k == ROUTEMSGS - 1 ? std::string(len, 'x') : "");
+      batch += "ZZAMSG#D01#T0#S#1#Z#10:22#X#Y#" + msg + "#";
+    }
+    batch += "....";
+    client->received.clear();
+    client->published.clear();
+    client->deliver("rocrail/service/info/tx", batch.c_str());
+    if (client->received.empty()){
+      break;                       // the batch itself is too large
+    }
+    run(100, runs);
+    unsigned routed = 0;
+    std::string payloads;
+    for (auto &m : client->received){
+      if (m.first == topic){
+        payloads += m.second.c_str();
+        routed++;
+      }
+    }
+    for (auto &m : client->published){
+      if (m.first == topic && m.first.length() + m.second.length() + 9 == client->maxPacket - 1u){
+        atLimit++;
+      }
+    }
+    split += (routed > 1);
+    for (const std::string &mark : marks){
+      if (payloads.find(mark) == std::string::npos){
+        printf("render: batch with last message of %u bytes, %s not received (%u payloads)\n", len, mark.c_str(), routed);
+        ok = false;
+      }
+    }
+  }
+  printf("render: %u routed payloads at the packet size limit, %u batches split\n", atLimit, split);
+  return ok && atLimit > 0 && split > 0;
+}
+
+
+// Call /bench after the start, args are the query arguments
+static std::string bench(const std::map<std::string, std::string> &args)
+{
+  PanelRun runs[PANELS];
+  run(2000, runs);
+  ESP8266WebServer *server = ESP8266WebServer::hostServer;
+  if (!server->request("/bench", args) || server->code != 200){
+    fprintf(stderr, "render: /bench failed\n");
+    exit(2);
+  }
+  return server->body;
+}
+
+
+// Glyph count and frame CRC32 of every template and case of /bench, without the draw time columns
+static std::string benchFrames()
+{
+  std::istringstream in(bench({}));
+  std::string out, line;
+  std::vector<bool> keep;
+  while (std::getline(in, line)){
+    std::vector<std::string> cols;
+    std::istringstream fields(line);
+    for (std::string c; std::getline(fields, c, ',');){
+      cols.push_back(c);
+    }
+    if (keep.empty()){
+      for (const std::string &c : cols){
+        keep.push_back(c.compare(0, 8, "draw_us_") != 0);
+      }
+    }
+    if (cols.size() != keep.size()){
+      fprintf(stderr, "render: unexpected /bench line %s\n", line.c_str());
+      exit(2);
+    }
+    std::string kept;
+    for (size_t k = 0; k < cols.size(); k++){
+      if (keep[k]){
+        kept += (kept.empty() ? "" : ",") + cols[k];
+      }
+    }
+    out += kept + "\n";
+  }
+  return out;
+}
+
+
+// First frame of every template for the case msg as XBM image
+static std::string benchImages()
+{
+  size_t from = hostSerialLog.size();
+  bench({ { "xbm", "1" } });
+  std::string log = hostSerialLog.substr(from), out;
+  const std::string head = "\nTemplate T";
+  for (size_t p = log.find(head); p != std::string::npos; ){
+    size_t next = log.find(head, p + 1);
+    std::string image = log.substr(p + 1, next == std::string::npos ? std::string::npos : next - p - 1);
+    if (image.find(", case msg ") != std::string::npos){
+      out += image;
+    }
+    p = next;
+  }
+  return out;
+}
+
+
+// /bench with draw times of the host clock, args are name=value query arguments
+static std::string benchTimes(int argc, char **argv)
+{
+  std::map<std::string, std::string> args;
+  for (int k = 0; k < argc; k++){
+    const char *eq = strchr(argv[k], '=');
+    args[eq != nullptr ? std::string(argv[k], eq - argv[k]) : argv[k]] = (eq != nullptr) ? eq + 1 : "";
+  }
+  hostWallClock = true;
+  std::string out = bench(args);
+  hostWallClock = false;
+  return out;
+}
+
+
+// Compare out with the recorded file, prints the lines that differ
+static bool compare(const char *file, const std::string &out)
+{
+  std::ifstream in(file, std::ios::binary);
+  std::stringstream golden;
+  golden << in.rdbuf();
+  if (golden.str() == out){
+    printf("render: all frames match %s\n", file);
+    return true;
+  }
+  std::istringstream a(golden.str()), b(out);
+  std::string la, lb;
+  for (;;){
+    la.clear();
+    lb.clear();
+    bool ga = (bool)std::getline(a, la);
+    bool gb = (bool)std::getline(b, lb);
+    if (!ga && !gb){
+      break;
+    }
+    if (la != lb){
+      printf("expected %-40s got %s\n", la.c_str(), lb.c_str());
+    }
+  }
+  return false;
+}
+
+
+int main(int argc, char **argv)
+{
+  setenv("TZ", "UTC0", 1);
+  tzset();
+  const char *mode = (argc > 1 && strncmp(argv[1], "--", 2) == 0) ? argv[1] : "";
+  int arg = (*mode != '\0') ? 2 : 1;
+  loadFiles(RMD_DATA, mode, strcmp(mode, "--boot") == 0 && argc > 2 && strcmp(argv[2], "fast") == 0);
+  setup();
+
+  const char *golden = (argc > arg) ? argv[arg] : nullptr;
+  std::string out;
+  if (strcmp(mode, "--bench") == 0){
+    out = benchFrames();
+  }
+  else if (strcmp(mode, "--xbm") == 0){
+    out = benchImages();
+  }
+  else if (strcmp(mode, "--cost") == 0){
+    out = scenarioCost();
+    golden = nullptr;
+  }
+  else if (strcmp(mode, "--clock") == 0){
+    out = clockCost();
+    golden = nullptr;
+  }
+  else if (strcmp(mode, "--boot") == 0){
+    out = bootTimeline();
+    golden = nullptr;
+  }
+  else if (strcmp(mode, "--route") == 0){
+    return routeCheck() ? 0 : 1;
+  }
+  else if (strcmp(mode, "--times") == 0){
+    out = benchTimes(argc - 2, argv + 2);
+    golden = nullptr;
+  }
+  else if (*mode == '\0'){
+    out = scenarioFrames();
+  }
+  else {
+    fprintf(stderr, "render: unknown option %s\n", mode);
+    return 2;
+  }
+  if (golden == nullptr){
+    fputs(out.c_str(), stdout);
+    return 0;
+  }
+  return compare(golden, out) ? 0 : 1;
+}
@@ -0,0 +1,503 @@
+// Roc-MQTT-Display HOST BUILD - U8g2 frame buffer simulation
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <U8g2lib.h>
+
+static const u8g2_cb_t rotation0 = { 0 };
+static const u8g2_cb_t rotation2 = { 2 };
+const u8g2_cb_t *U8G2_R0 = &rotation0;
+const u8g2_cb_t *U8G2_R2 = &rotation2;
+
+// advance, ascent, -descent, font number
+const uint8_t u8g2_font_5x7_tf[]             = { 5,  6, 1, 1 };
+const uint8_t u8g2_font_6x10_tf[]            = { 6,  7, 2, 2 };
+const uint8_t u8g2_font_7x13_tf[]            = { 7,  9, 2, 3 };
+const uint8_t u8g2_font_9x15_tf[]            = { 9, 10, 3, 4 };
+const uint8_t u8g2_font_crox1hb_tf[]         = { 7,  9, 2, 5 };
+const uint8_t u8g2_font_crox3hb_tf[]         = { 9, 12, 3, 6 };
+const uint8_t u8g2_font_crox4hb_tf[]         = { 11, 14, 4, 7 };
+const uint8_t u8g2_font_fur17_tf[]           = { 13, 17, 4, 8 };
+const uint8_t u8g2_font_helvR08_tf[]         = { 6,  8, 2, 9 };
+const uint8_t u8g2_font_rosencrantz_nbp_tf[] = { 6,  8, 2, 10 };
+
+HostPanel hostPanel[HOSTPANELS];
+int8_t hostMuxPort = -1;
+uint32_t hostUnselected = 0;       // transfers while no panel was selected at the multiplexer
+HostCalls hostCalls = {};
+
+
+// I2C byte callback of the display driver, the transfer already happened in the simulation
+static uint8_t hostByteCb(u8x8_t *, uint8_t, uint8_t, void *)
+{
+  return 1;
+}
+
+
+// Panel the display driver talks to
+static HostPanel &hostSelected()
+{
+  if (hostMuxPort < 0){
+    hostUnselected++;
+    return hostPanel[0];
+  }
+  return hostPanel[hostMuxPort];
+}
+
+
+// Controller commands, the ones the sketch uses
+static uint8_t hostCmdPending = 0;
+static void hostCommand(uint8_t cmd)
+{
+  HostPanel &p = hostSelected();
+  if (hostCmdPending == 0x81){
+    p.contrast = cmd;
+    hostCmdPending = 0;
+    return;
+  }
+  switch (cmd){
+    case 0xA6: p.invert = false; break;
+    case 0xA7: p.invert = true; break;
+    case 0xAE: p.powerSave = true; break;
+    case 0xAF: p.powerSave = false; break;
+    case 0x81: hostCmdPending = 0x81; break;
+    default: break;
+  }
+}
+
+
+extern "C" {
+uint8_t u8x8_cad_StartTransfer(u8x8_t *) { hostCmdPending = 0; return 1; }
+uint8_t u8x8_cad_SendCmd(u8x8_t *, uint8_t cmd) { hostCommand(cmd); return 1; }
+uint8_t u8x8_cad_SendArg(u8x8_t *, uint8_t arg) { hostCommand(arg); return 1; }
+uint8_t u8x8_cad_EndTransfer(u8x8_t *) { return 1; }
+}
+
+
+U8G2::U8G2(uint8_t width, uint8_t height, uint8_t xOffset, uint8_t flipXOffset) : width(width), height(height)
+{
+  buffer = (uint8_t *)calloc(width, height / 8);
+  info = { xOffset, flipXOffset, (uint8_t)(width / 8), (uint8_t)(height / 8) };
+  u8g2.u8x8.display_info = &info;
+  u8g2.u8x8.byte_cb = hostByteCb;
+  u8g2.u8x8.x_offset = xOffset;
+  u8g2.u8x8.i2c_address = 0x78;
+  u8g2.tile_buf_ptr = buffer;
+  u8g2.tile_buf_height = height / 8;
+  u8g2.tile_curr_row = 0;
+  font = u8g2_font_6x10_tf;
+  setMaxClipWindow();
+}
+
+
+U8G2::~U8G2()
+{
+  free(buffer);
+}
+
+
+bool U8G2::begin()
+{
+  initDisplay();
+  clearDisplay();
+  setPowerSave(0);
+  return true;
+}
+
+
+void U8G2::initDisplay()
+{
+  HostPanel &p = hostSelected();
+  p.width = width;
+  p.height = height;
+  p.flip = false;
+  p.powerSave = true;
+  u8g2.u8x8.x_offset = info.default_x_offset;
+}
+
+
+void U8G2::clearDisplay()
+{
+  clearBuffer();
+  sendBuffer();
+}
+
+
+void U8G2::setPowerSave(uint8_t is_enable)
+{
+  hostSelected().powerSave = (is_enable != 0);
+}
+
+
+void U8G2::setFlipMode(uint8_t mode)
+{
+  hostSelected().flip = (mode != 0);
+  u8g2.u8x8.x_offset = (mode != 0) ? info.flipmode_x_offset : info.default_x_offset;
+}
+
+
+void U8G2::setContrast(uint8_t value)
+{
+  hostSelected().contrast = value;
+}
+
+
+// c = command, a = argument, d = data
+void U8G2::sendF(const char *fmt, ...)
+{
+  va_list va;
+  va_start(va, fmt);
+  hostCmdPending = 0;
+  for (; *fmt != '\0'; fmt++){
+    uint8_t b = (uint8_t)va_arg(va, int);
+    if (*fmt == 'c' || *fmt == 'a'){
+      hostCommand(b);
+    }
+  }
+  va_end(va);
+}
+
+
+void U8G2::clearBuffer()
+{
+  memset(buffer, 0, (size_t)width * height / 8);
+}
+
+
+// Copy tile columns tx..tx+tw-1 of tile rows ty..ty+th-1 into the RAM of the selected panel
+void U8G2::transfer(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th)
+{
+  HostPanel &p = hostSelected();
+  p.width = width;
+  p.height = height;
+  u8x8_t *u8x8 = &u8g2.u8x8;
+  for (uint8_t row = ty; row < ty + th && row < height / 8; row++){
+    u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_START_TRANSFER, 0, nullptr);
+    for (uint16_t x = tx * 8; x < (tx + tw) * 8 && x < width; x++){
+      uint16_t col = x + u8x8->x_offset;
+      if (col < 132){
+        p.ram[row * 132 + col] = buffer[row * width + x];
+      }
+    }
+    u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_SEND, tw * 8, buffer + row * width + tx * 8);
+    u8x8->byte_cb(u8x8, U8X8_MSG_BYTE_END_TRANSFER, 0, nullptr);
+  }
+  p.transfers++;
+  p.bytes += tw * th * 8;
+}
+
+
+void U8G2::sendBuffer()
+{
+  transfer(0, 0, width / 8, height / 8);
+}
+
+
+void U8G2::firstPage()
+{
+  clearBuffer();
+  u8g2.tile_curr_row = 0;
+}
+
+
+uint8_t U8G2::nextPage()
+{
+  sendBuffer();
+  return 0;
+}
+
+
+void U8G2::updateDisplay()
+{
+  sendBuffer();
+}
+
+
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th)
+{
+  if (tx >= width / 8 || ty >= height / 8){
+    return;
+  }
+  transfer(tx, ty, std::min<uint8_t>(tw, width / 8 - tx), std::min<uint8_t>(th, height / 8 - ty));
+}
+
+
+// XBM image of the frame buffer
+void U8G2::writeBufferXBM(Print &p)
+{
+  p.printf("#define xbm_width %u\n#define xbm_height %u\nstatic unsigned char xbm_bits[] = {\n", width, height);
+  for (uint8_t y = 0; y < height; y++){
+    for (uint8_t x = 0; x < width; x += 8){
+      uint8_t b = 0;
+      for (uint8_t k = 0; k < 8; k++){
+        if (buffer[(y / 8) * width + x + k] & (1 << (y % 8))){
+          b |= 1 << k;
+        }
+      }
+      p.printf("0x%02x,", b);
+    }
+    p.print("\n");
+  }
+  p.print("};\n");
+}
+
+
+// PBM image of the frame buffer
+void U8G2::writeBufferPBM(Print &p)
+{
+  p.printf("P1\n%u %u\n", width, height);
+  for (uint8_t y = 0; y < height; y++){
+    for (uint8_t x = 0; x < width; x++){
+      p.print((buffer[(y / 8) * width + x] & (1 << (y % 8))) ? "1" : "0");
+    }
+    p.print("\n");
+  }
+}
+
+
+// Coordinates are unsigned like in U8g2, a position left of or above the display wraps around to a large number
+void U8G2::pixel(int x, int y, uint8_t color)
+{
+  if (x < clipX0 || x >= clipX1 || y < clipY0 || y >= clipY1){
+    return;
+  }
+  uint8_t &b = buffer[(y / 8) * width + x];
+  uint8_t bit = 1 << (y % 8);
+  if (color == 0){
+    b &= ~bit;
+  }
+  else if (color == 1){
+    b |= bit;
+  }
+  else {
+    b ^= bit;
+  }
+}
+
+
+void U8G2::drawPixel(u8g2_uint_t x, u8g2_uint_t y)
+{
+  pixel((int16_t)x, (int16_t)y, drawColor);
+}
+
+
+void U8G2::drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w)
+{
+  drawBox(x, y, w, 1);
+}
+
+
+void U8G2::drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h)
+{
+  drawBox(x, y, 1, h);
+}
+
+
+// Bresenham
+void U8G2::drawLine(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1)
+{
+  int xa = (int16_t)x0, ya = (int16_t)y0, xb = (int16_t)x1, yb = (int16_t)y1;
+  int dx = abs(xb - xa), sx = xa < xb ? 1 : -1;
+  int dy = -abs(yb - ya), sy = ya < yb ? 1 : -1;
+  int err = dx + dy;
+  for (;;){
+    pixel(xa, ya, drawColor);
+    if (xa == xb && ya == yb){
+      break;
+    }
+    int e2 = 2 * err;
+    if (e2 >= dy){
+      err += dy;
+      xa += sx;
+    }
+    if (e2 <= dx){
+      err += dx;
+      ya += sy;
+    }
+  }
+}
+
+
+void U8G2::drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  for (int yy = (int16_t)y; yy < (int16_t)y + (int)h; yy++){
+    for (int xx = (int16_t)x; xx < (int16_t)x + (int)w; xx++){
+      pixel(xx, yy, drawColor);
+    }
+  }
+}
+
+
+void U8G2::drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  if (w == 0 || h == 0){
+    return;
+  }
+  drawBox(x, y, w, 1);
+  drawBox(x, y + h - 1, w, 1);
+  drawBox(x, y + 1, 1, h - 2);
+  drawBox(x + w - 1, y + 1, 1, h - 2);
+}
+
+
+// Rows of (w + 7) / 8 bytes, LSB = left pixel. With bitmap mode 0 (solid) the 0 bits are drawn in the background color.
+void U8G2::drawXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  uint8_t ncolor = (drawColor == 0) ? 1 : 0;
+  uint16_t rowBytes = (w + 7) / 8;
+  for (uint16_t r = 0; r < h; r++){
+    for (uint16_t c = 0; c < w; c++){
+      if (bitmap[r * rowBytes + c / 8] & (1 << (c % 8))){
+        pixel((int16_t)x + c, (int16_t)y + r, drawColor);
+      }
+      else if (!bitmapTransparent){
+        pixel((int16_t)x + c, (int16_t)y + r, ncolor);
+      }
+    }
+  }
+}
+
+
+// Synthetic glyph: a pattern derived from the character and the font in a cell of advance x (ascent + descent),
+// the last column stays empty. In solid font mode the empty pixels of the cell are drawn in the background color.
+u8g2_uint_t U8G2::drawGlyph(u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
+{
+  if (encoding < 0x20){
+    return 0;
+  }
+  hostCalls.glyphs++;
+  uint8_t adv = font[0], asc = font[1], desc = font[2], id = font[3];
+  uint8_t bg = (drawColor == 0) ? 1 : 0;
+  for (uint8_t r = 0; r < asc + desc; r++){
+    for (uint8_t c = 0; c < adv; c++){
+      uint32_t v = (encoding * 2654435761u) ^ (id * 40503u) ^ ((uint32_t)c << 16) ^ ((uint32_t)r << 24);
+      v ^= v >> 13;
+      v *= 0x5bd1e995u;
+      v ^= v >> 15;
+      bool on = (encoding != ' ' && c < adv - 1 && (v & 3) != 0);
+      int px = (int16_t)x + c;
+      int py = (int16_t)y - asc + r;
+      if (on){
+        pixel(px, py, drawColor);
+      }
+      else if (!fontTransparent && drawColor != 2){
+        pixel(px, py, bg);
+      }
+    }
+  }
+  return adv;
+}
+
+
+// Next character of a UTF-8 string, false while a multibyte character is incomplete
+bool U8G2::decode(uint8_t c, uint16_t &e)
+{
+  if (utf8State == 0){
+    if (c >= 0xF0){
+      utf8State = 3;
+      utf8Code = c & 0x07;
+    }
+    else if (c >= 0xE0){
+      utf8State = 2;
+      utf8Code = c & 0x0F;
+    }
+    else if (c >= 0xC0){
+      utf8State = 1;
+      utf8Code = c & 0x1F;
+    }
+    else {
+      e = c;
+      return true;
+    }
+    return false;
+  }
+  utf8Code = (utf8Code << 6) | (c & 0x3F);
+  if (--utf8State > 0){
+    return false;
+  }
+  e = utf8Code;
+  return true;
+}
+
+
+u8g2_uint_t U8G2::drawStr(u8g2_uint_t x, u8g2_uint_t y, const char *s)
+{
+  u8g2_uint_t w = 0;
+  for (; *s != '\0'; s++){
+    w += drawGlyph(x + w, y, (uint8_t)*s);
+  }
+  return w;
+}
+
+
+u8g2_uint_t U8G2::drawUTF8(u8g2_uint_t x, u8g2_uint_t y, const char *s)
+{
+  u8g2_uint_t w = 0;
+  uint16_t e;
+  utf8State = 0;
+  for (; *s != '\0'; s++){
+    if (decode((uint8_t)*s, e)){
+      w += drawGlyph(x + w, y, e);
+    }
+  }
+  return w;
+}
+
+
+u8g2_uint_t U8G2::getUTF8Width(const char *s)
+{
+  hostCalls.widths++;
+  u8g2_uint_t w = 0;
+  uint16_t e;
+  utf8State = 0;
+  for (; *s != '\0'; s++){
+    if (decode((uint8_t)*s, e) && e >= 0x20){
+      w += font[0];
+    }
+  }
+  return w;
+}
+
+
+u8g2_uint_t U8G2::getStrWidth(const char *s)
+{
+  hostCalls.widths++;
+  u8g2_uint_t w = 0;
+  for (; *s != '\0'; s++){
+    if ((uint8_t)*s >= 0x20){
+      w += font[0];
+    }
+  }
+  return w;
+}
+
+
+void U8G2::setClipWindow(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1)
+{
+  clipX0 = std::max<int>(x0, 0);
+  clipY0 = std::max<int>(y0, 0);
+  clipX1 = std::min<int>(x1, width);
+  clipY1 = std::min<int>(y1, height);
+}
+
+
+void U8G2::setMaxClipWindow()
+{
+  clipX0 = 0;
+  clipY0 = 0;
+  clipX1 = width;
+  clipY1 = height;
+}
+
+
+// Print at the cursor, UTF-8 after enableUTF8Print()
+size_t U8G2::write(uint8_t c)
+{
+  uint16_t e = c;
+  if (utf8Print && !decode(c, e)){
+    return 1;
+  }
+  tx += drawGlyph(tx, ty, e);
+  return 1;
+}
@@ -0,0 +1,103 @@
+// Roc-MQTT-Display HOST TESTS - logo registry
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// logos.h defines the logo table, only this test includes it
+#include "check.h"                 // strlcpy for logos.h
+#include <string>
+#include <logos.h>
+
+static const uint8_t bitsA[] = { 0x01 };
+static const uint8_t bitsB[] = { 0x02 };
+
+
+TEST(logos, add_find)
+{
+  logoClear();
+  CHECK(logoFind("ICE") == LOGO_NONE);
+  CHECK(logoAdd("ICE", 8, 1, bitsA, false));
+  CHECK(logoAdd("IC", 8, 1, bitsB, false));
+  uint16_t ice = logoFind("ICE");
+  CHECK(ice != LOGO_NONE && logoGet(ice).bits == bitsA);
+  CHECK(logoGet(logoFind("IC")).bits == bitsB);
+  CHECK(logoFind("") == LOGO_NONE);
+  CHECK(logoFind("I") == LOGO_NONE);
+
+  // Replacing keeps the handle
+  CHECK(logoAdd("ICE", 8, 1, bitsB, false));
+  CHECK(logoFind("ICE") == ice && logoGet(ice).bits == bitsB);
+  CHECK(logoCount == 2);
+}
+
+
+// More logos than buckets and initial table capacity
+TEST(logos, many)
+{
+  logoClear();
+  char id[LOGOIDLEN];
+  for (uint16_t k = 0; k < 100; k++){
+    snprintf(id, sizeof(id), "L%u", k);
+    CHECK(logoAdd(id, 8, 1, (k & 1) ? bitsB : bitsA, false));
+  }
+  CHECK(logoCount == 100);
+  for (uint16_t k = 0; k < 100; k++){
+    snprintf(id, sizeof(id), "L%u", k);
+    uint16_t n = logoFind(id);
+    CHECK(n != LOGO_NONE && strcmp(logoGet(n).id, id) == 0);
+  }
+  logoClear();
+  CHECK(logoFind("L1") == LOGO_NONE);
+}
+
+
+// IDs that don't fit are rejected, cut they would share the logo of their first characters
+TEST(logos, long_id)
+{
+  logoClear();
+  CHECK(logoAdd("ABCDEFG", 8, 1, bitsA, false));
+  CHECK(!logoAdd("ABCDEFGH", 8, 1, bitsB, false));
+  CHECK(!logoAdd("ABCDEFGXYZ", 8, 1, bitsB, false));
+  CHECK(logoCount == 1);
+  CHECK(logoGet(logoFind("ABCDEFG")).bits == bitsA);
+  CHECK(logoFind("ABCDEFGH") == LOGO_NONE);
+}
+
+
+TEST(logos, parse_xbm)
+{
+  std::string s = "#define ice_width 10\n#define ice_height 2\nstatic unsigned char ice_bits[] = {\n  0x01, 0x02, 0xff, 0x03 };\n";
+  uint8_t w = 0, h = 0;
+  uint8_t out[4];
+  CHECK(logoParse(s.c_str(), s.size(), w, h, nullptr) == 4);
+  CHECK(w == 10 && h == 2);
+  CHECK(logoParse(s.c_str(), s.size(), w, h, out) == 4);
+  CHECK(out[0] == 0x01 && out[1] == 0x02 && out[2] == 0xff && out[3] == 0x03);
+
+  // Fewer bytes than the size
+  s = "#define x_width 16\n#define x_height 2\nstatic unsigned char x_bits[] = { 0x01, 0x02 };\n";
+  CHECK(logoParse(s.c_str(), s.size(), w, h, out) == 0);
+  s = "#define x_width 0\n#define x_height 2\nstatic unsigned char x_bits[] = { 0x01 };\n";
+  CHECK(logoParse(s.c_str(), s.size(), w, h, nullptr) == 0);
+}
+
+
+// PBM rows are MSB first, the bitmap LSB first like XBM
+TEST(logos, parse_pbm)
+{
+  std::string s = "P1\n# comment\n3 2\n1 0 1\n0 1 1\n";
+  uint8_t w = 0, h = 0;
+  uint8_t out[2];
+  CHECK(logoParse(s.c_str(), s.size(), w, h, out) == 2);
+  CHECK(w == 3 && h == 2);
+  CHECK(out[0] == 0x05 && out[1] == 0x06);
+
+  s = std::string("P4\n9 1\n") + "\x80\x80";
+  uint8_t out4[2];
+  CHECK(logoParse(s.data(), s.size(), w, h, out4) == 2);
+  CHECK(w == 9 && h == 1);
+  CHECK(out4[0] == 0x01 && out4[1] == 0x01);
+
+  s = "P1 2 1 1";
+  CHECK(logoParse(s.c_str(), s.size(), w, h, out) == 0);
+}
@@ -0,0 +1,30 @@
+// Roc-MQTT-Display HOST TESTS
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+// Runs the tests of the groups given as arguments, all tests without arguments
+//   host_tests zzamsg rrclock
+
+#include "check.h"
+
+
+int main(int argc, char **argv)
+{
+  int run = 0;
+  for (TestCase *t = testList(); t != nullptr; t = t->next){
+    bool selected = (argc < 2);
+    for (int k = 1; k < argc; k++){
+      selected |= (strcmp(argv[k], t->group) == 0);
+    }
+    if (!selected){
+      continue;
+    }
+    int failures = checkFailures();
+    t->fn();
+    printf("%-8s %-24s %s\n", t->group, t->name, checkFailures() == failures ? "ok" : "FAILED");
+    run++;
+  }
+  printf("%d tests, %d failed checks\n", run, checkFailures());
+  return (run > 0 && checkFailures() == 0) ? 0 : 1;
+}
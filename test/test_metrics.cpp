@@ -0,0 +1,78 @@
+// Roc-MQTT-Display HOST TESTS - metrics.h
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include "check.h"
+#include "metrics.h"
+
+
+// Minimum, maximum, average and histogram bins
+TEST(metrics, timing)
+{
+  TaskTiming m = {};
+  CHECK(timingAvg(m) == 0);
+  CHECK(timingP99(m) == 0);
+  timingAdd(m, 10);
+  timingAdd(m, 0);
+  timingAdd(m, 1);
+  timingAdd(m, 1000);
+  CHECK(m.count == 4);
+  CHECK(m.minUs == 0);
+  CHECK(m.maxUs == 1000);
+  CHECK(timingAvg(m) == 252);
+  CHECK(m.bins[0] == 2);           // 0 and 1
+  CHECK(m.bins[3] == 1);           // 8-15
+  CHECK(m.bins[9] == 1);           // 512-1023
+  timingAdd(m, 0xFFFFFFFFu);
+  CHECK(m.bins[TIMEBINS - 1] == 1);
+}
+
+
+// The 99th percentile is the upper bound of its bin, limited to the maximum
+TEST(metrics, percentile)
+{
+  TaskTiming m = {};
+  for (int k = 0; k < 100; k++){
+    timingAdd(m, 10);
+  }
+  CHECK(timingP99(m) == 10);       // bin 8-15, but the maximum is 10
+  timingAdd(m, 5000);
+  CHECK(timingP99(m) == 15);       // 100 of 101 runs <= 15
+  for (int k = 0; k < 5; k++){
+    timingAdd(m, 5000);
+  }
+  CHECK(timingP99(m) == 5000);     // 4096-8191, limited to the maximum
+}
+
+
+TEST(metrics, schedule)
+{
+  TaskTiming m = {};
+  timingSchedule(m, 5, 0);
+  timingSchedule(m, -3, 3);
+  timingSchedule(m, -1, 1);
+  CHECK(m.overruns == 2);
+  CHECK(m.maxDelayMs == 3);
+}
+
+
+// Boot timeline, full table and truncated text
+TEST(metrics, boot_timeline)
+{
+  char out[64];
+  CHECK(bootFormat(out, sizeof(out)) == 0 && out[0] == '\0');
+  bootMark("serial", 610000);
+  bootMark("config", 655000);
+  size_t n = bootFormat(out, sizeof(out));
+  CHECK(strcmp(out, "serial 0.61 s, config 0.65 s") == 0);
+  CHECK(n == strlen(out));
+  char small[10];
+  n = bootFormat(small, sizeof(small));
+  CHECK(n == sizeof(small) - 1 && strlen(small) == n);
+  for (int k = 0; k < BOOTPHASES + 3; k++){
+    bootMark("x", k);
+  }
+  CHECK(bootPhaseCount == BOOTPHASES);
+}
+
@@ -0,0 +1,96 @@
+// Roc-MQTT-Display HOST TESTS - railroad clock
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <string>
+#include <rrclock.h>
+#include "check.h"
+
+static bool parse(const std::string &s, RRClock &c)
+{
+  return rrClockParse(s.data(), s.size(), c);
+}
+
+
+TEST(rrclock, sync)
+{
+  RRClock c;
+  CHECK(parse("<clock divider=\"1\" hour=\"18\" minute=\"40\" wday=\"5\" mday=\"12\" month=\"2\" year=\"2021\" time=\"1613151626\" "
+              "temp=\"20\" bri=\"255\" lux=\"0\" pressure=\"0\" humidity=\"0\" cmd=\"sync\"/>", c));
+  CHECK(c.hour == 18 && c.minute == 40);
+  CHECK(c.wday == 5 && c.mday == 12 && c.month == 2 && c.year == 2021);
+}
+
+
+// The old parser cut the values between the positions of the next attribute names
+TEST(rrclock, any_order)
+{
+  RRClock c;
+  CHECK(parse("<clock cmd=\"sync\" year=\"2024\" minute=\"7\" month=\"12\" hour=\"0\" mday=\"31\" wday=\"2\"/>", c));
+  CHECK(c.hour == 0 && c.minute == 7);
+  CHECK(c.wday == 2 && c.mday == 31 && c.month == 12 && c.year == 2024);
+
+  CHECK(parse("<clock\n\thour=\"9\"\r\nminute=\"05\"/>", c));
+  CHECK(c.hour == 9 && c.minute == 5);
+  CHECK(c.wday == -1 && c.mday == -1 && c.month == -1 && c.year == -1);
+}
+
+
+// Names that end with a clock attribute name are other attributes
+TEST(rrclock, similar_names)
+{
+  RRClock c;
+  CHECK(parse("<clock starthour=\"3\" hour=\"4\" xminute=\"1\" minute=\"2\" dayyear=\"7\"/>", c));
+  CHECK(c.hour == 4 && c.minute == 2 && c.year == -1);
+
+  CHECK(!parse("<clock hours=\"4\" minutes=\"2\"/>", c));
+  CHECK(c.hour == -1 && c.minute == -1);
+}
+
+
+TEST(rrclock, missing_values)
+{
+  RRClock c;
+  CHECK(!parse("", c));
+  CHECK(!parse("<clock hour=\"18\" wday=\"5\"/>", c));
+  CHECK(c.hour == 18 && c.minute == -1 && c.wday == 5);
+  CHECK(!parse("<clock hour=\"\" minute=\"40\"/>", c));
+  CHECK(c.hour == -1 && c.minute == 40);
+  CHECK(!parse("<clock hour=18 minute=40/>", c));
+  CHECK(!parse("<clock hour=\"x\" minute=\"40\"/>", c));
+}
+
+
+// Values out of range count as not found, they would not fit the time and date variables
+TEST(rrclock, range)
+{
+  RRClock c;
+  CHECK(parse("<clock hour=\"23\" minute=\"59\" wday=\"7\" mday=\"31\" month=\"12\" year=\"9999\"/>", c));
+  CHECK(c.hour == 23 && c.minute == 59 && c.wday == 7 && c.mday == 31 && c.month == 12 && c.year == 9999);
+  CHECK(parse("<clock hour=\"0023\" minute=\"0\"/>", c));
+  CHECK(c.hour == 23 && c.minute == 0);
+
+  CHECK(!parse("<clock hour=\"24\" minute=\"0\"/>", c));
+  CHECK(c.hour == -1);
+  CHECK(!parse("<clock hour=\"1\" minute=\"60\"/>", c));
+  CHECK(parse("<clock hour=\"1\" minute=\"2\" mday=\"32\" month=\"13\" year=\"10000\" wday=\"8\"/>", c));
+  CHECK(c.mday == -1 && c.month == -1 && c.year == -1 && c.wday == -1);
+  CHECK(parse("<clock hour=\"1\" minute=\"2\" year=\"99999999999999999999\"/>", c));
+  CHECK(c.year == -1);
+}
+
+
+// The payload is not null terminated, a value ends with the payload
+TEST(rrclock, unterminated)
+{
+  RRClock c;
+  CHECK(parse("<clock hour=\"18\" minute=\"4", c));
+  CHECK(c.hour == 18 && c.minute == 4);
+
+  const char *s = "<clock hour=\"18\" minute=\"40\"/>";
+  CHECK(rrClockParse(s, 26, c));               // ends after minute="4
+  CHECK(c.minute == 4);
+  CHECK(!rrClockParse(s, 24, c));              // ends before the value
+  CHECK(c.hour == 18 && c.minute == -1);
+}
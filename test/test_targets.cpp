@@ -0,0 +1,69 @@
+// Roc-MQTT-Display HOST TESTS - display targets
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <string>
+#include <zzamsg.h>
+#include "check.h"
+
+// D01 on display 1 and 3, D1 on 2, D10 on 4, B01 on 5
+static const DisplayId ids[] = {
+  { "D01", 3, 0x05 },
+  { "D1",  2, 0x02 },
+  { "D10", 3, 0x08 },
+  { "B01", 3, 0x10 },
+};
+
+static DispMask mask(const std::string &s)
+{
+  return targetMask(s.data(), s.size(), ids, sizeof(ids) / sizeof(ids[0]));
+}
+
+
+// IDs match completely, D1 doesn't address D10 or D01
+TEST(targets, exact_match)
+{
+  CHECK(mask("D01") == 0x05);
+  CHECK(mask("D1") == 0x02);
+  CHECK(mask("D10") == 0x08);
+  CHECK(mask("D100") == 0);
+  CHECK(mask("D001") == 0);
+  CHECK(mask("D") == 0);
+  CHECK(mask("d01") == 0);
+  CHECK(mask("") == 0);
+}
+
+
+TEST(targets, lists)
+{
+  CHECK(mask("D01D10") == 0x0D);
+  CHECK(mask("D1D10") == 0x0A);
+  CHECK(mask("D10D1") == 0x0A);
+  CHECK(mask("D01B01") == 0x15);
+  CHECK(mask("D01D01") == 0x05);
+  CHECK(mask("D09D1") == 0x02);
+  CHECK(mask("X7D10") == 0x08);
+}
+
+
+// Blanks, commas and semicolons between IDs are skipped
+TEST(targets, separators)
+{
+  CHECK(mask("D01 D10") == 0x0D);
+  CHECK(mask("D1,D10") == 0x0A);
+  CHECK(mask("D1;B01") == 0x12);
+  CHECK(mask(" ,D1; ") == 0x02);
+  CHECK(mask(",,;") == 0);
+}
+
+
+// The field is not null terminated, an ID ends with the field
+TEST(targets, span)
+{
+  const char *s = "D1D10";
+  CHECK(targetMask(s, 2, ids, 4) == 0x02);
+  CHECK(targetMask(s, 4, ids, 4) == 0x02);      // "D1" then "D1"
+  CHECK(targetMask(s, 5, ids, 4) == 0x0A);
+  CHECK(targetMask(s, 5, ids, 0) == 0);
+}
@@ -0,0 +1,95 @@
+// Roc-MQTT-Display HOST TESTS - message variables
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <string>
+#include <zzamsg.h>
+#include "check.h"
+
+static const char *const values[4] = { "18:40", "12.02.2021", "08:15", "01.03.2024" };
+
+// Compile and expand src into a field of size bytes
+static std::string expand(const char *src, size_t size, uint8_t max = 9, uint8_t allowed = VAR_ALL)
+{
+  VarSeg seg[16];
+  uint8_t vars = 0;
+  uint8_t n = compileVars(src, seg, max, allowed, vars);
+  char field[256];
+  expandVars(field, size, src, seg, n, values);
+  return field;
+}
+
+
+TEST(vars, compile)
+{
+  VarSeg seg[9];
+  uint8_t vars = 0;
+  CHECK(compileVars("Ankunft {rrtime} Uhr", seg, 9, VAR_ALL, vars) == 3);
+  CHECK(vars == VAR_RRTIME);
+  CHECK(seg[0].var == 0 && seg[0].pos == 0 && seg[0].len == 8);
+  CHECK(seg[1].var == 1);
+  CHECK(seg[2].var == 0 && seg[2].pos == 16 && seg[2].len == 4);
+
+  vars = 0;
+  CHECK(compileVars("{ntpdate}{ntptime}", seg, 9, VAR_ALL, vars) == 2);
+  CHECK(vars == (VAR_NTPDATE | VAR_NTPTIME));
+  CHECK(seg[0].var == 4 && seg[1].var == 3);
+
+  // Nothing to compile
+  vars = 0;
+  CHECK(compileVars("", seg, 9, VAR_ALL, vars) == 0);
+  CHECK(compileVars("Zugdurchfahrt", seg, 9, VAR_ALL, vars) == 1);
+  CHECK(vars == 0);
+}
+
+
+TEST(vars, expand)
+{
+  CHECK(expand("Ankunft {rrtime} Uhr", 64) == "Ankunft 18:40 Uhr");
+  CHECK(expand("{ntpdate} {ntptime}", 64) == "01.03.2024 08:15");
+  CHECK(expand("{rrdate}", 64) == "12.02.2021");
+  CHECK(expand("{rrtime}{rrtime}", 64) == "18:4018:40");
+  CHECK(expand("Zugdurchfahrt", 64) == "Zugdurchfahrt");
+  CHECK(expand("", 64) == "");
+}
+
+
+// Unknown, incomplete and not allowed names are text
+TEST(vars, not_variables)
+{
+  CHECK(expand("{time} {rrtime", 64) == "{time} {rrtime");
+  CHECK(expand("{{rrtime}}", 64) == "{18:40}");
+  CHECK(expand("{RRTIME}", 64) == "{RRTIME}");
+  CHECK(expand("{rrtime} {ntptime}", 64, 9, VAR_RRTIME) == "18:40 {ntptime}");
+}
+
+
+// Variables beyond the segments are shown as received
+TEST(vars, segment_limit)
+{
+  CHECK(expand("a{rrtime}b{rrtime}c{rrtime}d{rrtime}e{rrtime}f", 64) == "a18:40b18:40c18:40d18:40e{rrtime}f");
+  // Adjacent variables need no literal segments
+  CHECK(expand("{rrtime}{rrtime}{rrtime}{rrtime}{rrtime}{rrtime}{rrtime}{rrtime}", 64) == "18:4018:4018:4018:4018:4018:4018:40{rrtime}");
+  // Departure, one variable
+  CHECK(expand("{rrtime} {rrtime}", 64, 3) == "18:40 {rrtime}");
+}
+
+
+// A literal is cut at a UTF-8 character boundary, a variable that doesn't fit is left out
+TEST(vars, truncation)
+{
+  CHECK(expand("Ankunft {rrtime} Uhr", 12) == "Ankunft ");
+  CHECK(expand("Ankunft {rrtime} Uhr", 14) == "Ankunft 18:40");
+  CHECK(expand("Ankunft {rrtime} Uhr", 16) == "Ankunft 18:40 U");
+  CHECK(expand("Verspätung {rrtime}", 6) == "Versp");
+  CHECK(expand("Verspätung {rrtime}", 7) == "Versp");
+  CHECK(expand("Verspätung {rrtime}", 8) == "Verspä");
+  CHECK(expand("{rrtime}", 5) == "");
+  CHECK(expand("x", 1) == "");
+
+  // Longest received message (ZZA_MSGLEN - 1), segment positions and lengths are uint8_t
+  std::string src = std::string(183, 'x') + "{rrtime}" + std::string(9, 'y');
+  CHECK(expand(src.c_str(), 201) == std::string(183, 'x') + "18:40" + std::string(9, 'y'));
+  CHECK(expand(src.c_str(), 190) == std::string(183, 'x') + "18:40" + "y");
+}
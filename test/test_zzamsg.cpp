@@ -0,0 +1,297 @@
+// Roc-MQTT-Display HOST TESTS - ZZAMSG parser
+// Version 1.13
+// Copyright (c) 2020-2024 Christian Heinrichs. All rights reserved.
+// https://github.com/chrisweather/RocMQTTdisplay
+
+#include <string>
+#include <zzamsg.h>
+#include "check.h"
+
+// Parse a copy of s that stays valid until the next call, the fields point into it
+static bool parse(const std::string &s, ZZAMsg &msg, const char *delim = "")
+{
+  static std::string payload;
+  payload = s;
+  return zzaParse(payload.data(), payload.size(), delim, msg);
+}
+
+
+TEST(zzamsg, fields)
+{
+  ZZAMsg msg;
+  CHECK(parse("ZZAMSG#D01D02#T1#Bhf01#2#Köln-Bonn#10:22#ICE 597#ICE#5min Verspätung###", msg));
+  CHECK(msg.count == ZZAF_COUNT);
+  CHECK_SPAN(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, "D01D02");
+  CHECK_SPAN(msg.field[ZZAF_TEMPLATE].ptr, msg.field[ZZAF_TEMPLATE].len, "T1");
+  CHECK_SPAN(msg.field[ZZAF_STATION].ptr, msg.field[ZZAF_STATION].len, "Bhf01");
+  CHECK_SPAN(msg.field[ZZAF_TRACK].ptr, msg.field[ZZAF_TRACK].len, "2");
+  CHECK_SPAN(msg.field[ZZAF_DESTINATION].ptr, msg.field[ZZAF_DESTINATION].len, "Köln-Bonn");
+  CHECK_SPAN(msg.field[ZZAF_DEPARTURE].ptr, msg.field[ZZAF_DEPARTURE].len, "10:22");
+  CHECK_SPAN(msg.field[ZZAF_TRAIN].ptr, msg.field[ZZAF_TRAIN].len, "ICE 597");
+  CHECK_SPAN(msg.field[ZZAF_TYPE].ptr, msg.field[ZZAF_TYPE].len, "ICE");
+  CHECK_SPAN(msg.field[ZZAF_MESSAGE].ptr, msg.field[ZZAF_MESSAGE].len, "5min Verspätung");
+  CHECK(msg.field[ZZAF_SPARE1].len == 0);
+  CHECK(msg.field[ZZAF_SPARE2].len == 0);
+  CHECK(msg.mask == 0);
+}
+
+
+TEST(zzamsg, identifier)
+{
+  ZZAMsg msg;
+  CHECK(!parse("", msg));
+  CHECK(!parse("ZZAMSG", msg));
+  CHECK(!parse("ZZAMSGD01#T0", msg));
+  CHECK(!parse("zzamsg#D01#T0", msg));
+  CHECK(!parse(" ZZAMSG#D01#T0", msg));
+  CHECK(msg.count == 0);
+  CHECK(parse("ZZAMSG#", msg));
+  CHECK(msg.count == 0);
+}
+
+
+// Missing fields are empty and point to the end of the payload, a last field needs no separator
+TEST(zzamsg, short_payload)
+{
+  ZZAMsg msg;
+  std::string s = "ZZAMSG#D01#T6#Gartenstadt";
+  CHECK(zzaParse(s.data(), s.size(), "", msg));
+  CHECK(msg.count == 3);
+  CHECK_SPAN(msg.field[ZZAF_STATION].ptr, msg.field[ZZAF_STATION].len, "Gartenstadt");
+  for (uint8_t f = ZZAF_TRACK; f < ZZAF_COUNT; f++){
+    CHECK(msg.field[f].len == 0);
+    CHECK(msg.field[f].ptr == s.data() + s.size());
+  }
+
+  CHECK(parse("ZZAMSG#D01D02###########", msg));
+  CHECK(msg.count == ZZAF_COUNT);
+  CHECK_SPAN(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, "D01D02");
+  for (uint8_t f = ZZAF_TEMPLATE; f < ZZAF_COUNT; f++){
+    CHECK(msg.field[f].len == 0);
+  }
+}
+
+
+// Fields after the eleventh are ignored, "...." padding of Rocrail lands there
+TEST(zzamsg, extra_fields)
+{
+  ZZAMsg msg;
+  CHECK(parse("ZZAMSG#D01#T0#a#b#c#d#e#f#g#s1#s2#extra#....", msg));
+  CHECK(msg.count == ZZAF_COUNT);
+  CHECK_SPAN(msg.field[ZZAF_MESSAGE].ptr, msg.field[ZZAF_MESSAGE].len, "g");
+  CHECK_SPAN(msg.field[ZZAF_SPARE2].ptr, msg.field[ZZAF_SPARE2].len, "s2");
+}
+
+
+// The MQTT delimiter separates fields like "#", also with more than one character and mixed with "#"
+TEST(zzamsg, delimiter)
+{
+  ZZAMsg msg;
+  CHECK(parse("ZZAMSG;D01;T0;Bhf01;1;Bonn", msg, ";"));
+  CHECK(msg.count == 5);
+  CHECK_SPAN(msg.field[ZZAF_DESTINATION].ptr, msg.field[ZZAF_DESTINATION].len, "Bonn");
+
+  CHECK(parse("ZZAMSG , D01 , T0#Bhf01 , 1 , Bonn , 10:22", msg, " , "));
+  CHECK(msg.count == 6);
+  CHECK_SPAN(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, "D01");
+  CHECK_SPAN(msg.field[ZZAF_TEMPLATE].ptr, msg.field[ZZAF_TEMPLATE].len, "T0");
+  CHECK_SPAN(msg.field[ZZAF_STATION].ptr, msg.field[ZZAF_STATION].len, "Bhf01");
+  CHECK_SPAN(msg.field[ZZAF_DEPARTURE].ptr, msg.field[ZZAF_DEPARTURE].len, "10:22");
+
+  // A delimiter cut by the end of the payload is text
+  CHECK(parse("ZZAMSG , D01 ,", msg, " , "));
+  CHECK(msg.count == 1);
+  CHECK_SPAN(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, "D01 ,");
+
+  // Without a delimiter only "#" separates
+  CHECK(parse("ZZAMSG#D01;D02#T0", msg, ""));
+  CHECK_SPAN(msg.field[ZZAF_TARGETS].ptr, msg.field[ZZAF_TARGETS].len, "D01;D02");
+  CHECK(parse("ZZAMSG#D01;D02#T0", msg, nullptr));
+  CHECK(msg.count == 2);
+}
+
+
+// Offsets beyond 255 bytes, the old parser kept them in uint8_t
+TEST(zzamsg, long_payload)
+{
+  ZZAMsg msg;
+  std::string text(300, 'x');
+  std::string s = "ZZAMSG#D01#T1#Bhf01#4#Hamburg-Hbf#08:17#ICE 597#ICE#" + text + "#spare#";
+  CHECK(zzaParse(s.data(), s.size(), "", msg));
+  CHECK(msg.count == ZZAF_SPARE2);
+  CHECK(msg.field[ZZAF_MESSAGE].len == 300);
+  CHECK_SPAN(msg.field[ZZAF_SPARE1].ptr, msg.field[ZZAF_SPARE1].len, "spare");
+  CHECK(msg.field[ZZAF_SPARE1].ptr - s.data() > 255);
+}
+
+
+// Only the digits of the field are read, the field is not null terminated
+TEST(zzamsg, template_number)
+{
+  const char *s = "T0T3T9T10TT7xT12";
+  CHECK(zzaTemplate({ s, 2 }) == 0);
+  CHECK(zzaTemplate({ s + 2, 2 }) == 3);
+  CHECK(zzaTemplate({ s + 4, 2 }) == 9);
+  CHECK(zzaTemplate({ s + 6, 3 }) == 0);
+  CHECK(zzaTemplate({ s + 9, 1 }) == 0);
+  CHECK(zzaTemplate({ s + 10, 3 }) == 7);
+  CHECK(zzaTemplate({ s + 13, 2 }) == 1);
+  CHECK(zzaTemplate({ s, 0 }) == 0);
+}
+
+
+// Fields are cut to the buffer without splitting a UTF-8 character
+TEST(zzamsg, set_field)
+{
+  char f[8];
+  setField(f, sizeof(f), "Bonn", 4);
+  CHECK(strcmp(f, "Bonn") == 0);
+  setField(f, sizeof(f), "Bonn Hbf", 8);
+  CHECK(strcmp(f, "Bonn Hb") == 0);
+  setField(f, sizeof(f), "Bonn", -1);
+  CHECK(f[0] == '\0');
+  setField(f, sizeof(f), "Zürich HB", 10);     // ü = 2 bytes, fits
+  CHECK(strcmp(f, "Zürich") == 0);
+  setField(f, sizeof(f), "Straße 1", 9);       // ß at bytes 4-5
+  CHECK(strcmp(f, "Straße") == 0);
+  setField(f, sizeof(f), "Gleis ßx", 9);       // ß at bytes 6-7, cut before it
+  CHECK(strcmp(f, "Gleis ") == 0);
+  setField(f, sizeof(f), "€€€", 9);            // 3 byte characters
+  CHECK(strcmp(f, "€€") == 0);
+}
+
+
+// Records of a ZZABATCH payload end at the next ZZAMSG identifier
+TEST(zzamsg, batch_record)
+{
+  std::string s = "ZZAMSG#D01#T0#Bhf01#1###ZZAMSG#D02#T6#Gartenstadt#ZZAMSG#D03";
+  const char *p = s.data();
+  const char *end = p + s.size();
+  size_t n = zzaBatchRecord(p, end);
+  CHECK(std::string(p, n) == "ZZAMSG#D01#T0#Bhf01#1###");
+  p += n;
+  n = zzaBatchRecord(p, end);
+  CHECK(std::string(p, n) == "ZZAMSG#D02#T6#Gartenstadt#");
+  p += n;
+  n = zzaBatchRecord(p, end);
+  CHECK(std::string(p, n) == "ZZAMSG#D03");
+  CHECK(p + n == end);
+}
+
+
+// Encode a text message as ZZAMSG v2 and read it back
+TEST(zza2, round_trip)
+{
+  std::string s = "ZZAMSG#D01D02#T1#Bhf01#2#Köln-Bonn#10:22#ICE 597#ICE#5min Verspätung#s1#s2#";
+  ZZAMsg msg;
+  CHECK(zzaParse(s.data(), s.size(), "", msg));
+  msg.mask = 0x8000002A;
+  char out[256];
+  size_t n = zza2Encode(msg, out, sizeof(out));
+  CHECK(n > 0);
+  CHECK(out[n] == '\0' && memchr(out, '\0', n) == nullptr);
+  CHECK(zza2Is(out, n));
+  ZZAMsg v2;
+  CHECK(zza2Parse(out + 2, out + n, v2) == out + n);
+  CHECK(v2.count == ZZAF_COUNT);
+  CHECK(v2.mask == 0x8000002A);
+  for (uint8_t f = 0; f < ZZAF_COUNT; f++){
+    CHECK(v2.field[f].len == msg.field[f].len && memcmp(v2.field[f].ptr, msg.field[f].ptr, msg.field[f].len) == 0);
+  }
+}
+
+
+// Empty fields are left out, missing fields are empty
+TEST(zza2, empty_fields)
+{
+  ZZAMsg msg;
+  CHECK(zzaParse("ZZAMSG#D03###########", 21, "", msg));
+  char out[64];
+  size_t n = zza2Encode(msg, out, sizeof(out));
+  CHECK(n == 7);
+  CHECK(memcmp(out, "\xA5" "2" "\x20\x23" "D03", 7) == 0);
+  ZZAMsg v2;
+  CHECK(zza2Parse(out + 2, out + n, v2) == out + n);
+  CHECK(v2.count == 1);
+  CHECK_SPAN(v2.field[ZZAF_TARGETS].ptr, v2.field[ZZAF_TARGETS].len, "D03");
+  CHECK(v2.field[ZZAF_MESSAGE].len == 0 && v2.mask == 0);
+
+  CHECK(!zza2Is("\xA5", 1));
+  CHECK(!zza2Is("\xA5" "1", 2));
+  CHECK(!zza2Is("ZZAMSG#", 7));
+}
+
+
+// ZZA2_NEXT separates messages of one payload, unknown tags are skipped
+TEST(zza2, several_messages)
+{
+  // D01 T0 Bonn, then an unknown tag 0x15, then mask 3 with the message Zugdurchfahrt
+  const std::string p = std::string("\xA5" "2") + "\x20\x23" "D01" "\x21\x22" "T0" "\x24\x24" "Bonn" "\x31\x20"
+                        + "\x35\x21" "x" "\x30\x21" "3" "\x28\x2D" "Zugdurchfahrt";
+  const char *s = p.data() + 2;
+  const char *end = p.data() + p.size();
+  ZZAMsg msg;
+  s = zza2Parse(s, end, msg);
+  CHECK(s != nullptr && s < end);
+  CHECK(msg.count == ZZAF_DESTINATION + 1);
+  CHECK_SPAN(msg.field[ZZAF_DESTINATION].ptr, msg.field[ZZAF_DESTINATION].len, "Bonn");
+  CHECK(msg.mask == 0);
+  s = zza2Parse(s, end, msg);
+  CHECK(s == end);
+  CHECK(msg.count == ZZAF_MESSAGE + 1);
+  CHECK(msg.field[ZZAF_TARGETS].len == 0);
+  CHECK_SPAN(msg.field[ZZAF_MESSAGE].ptr, msg.field[ZZAF_MESSAGE].len, "Zugdurchfahrt");
+  CHECK(msg.mask == 3);
+}
+
+
+// A payload cut inside a record is rejected, cut between records it is a shorter message
+TEST(zza2, truncated)
+{
+  const std::string p = std::string("\xA5" "2") + "\x20\x23" "D01" "\x28\x25" "Hallo";
+  const char *s = p.data() + 2;
+  ZZAMsg msg;
+  for (size_t n = 1; n < p.size() - 2; n++){
+    const char *r = zza2Parse(s, s + n, msg);
+    CHECK(n == 5 ? r == s + n : r == nullptr);
+  }
+  CHECK(zza2Parse(s, s, msg) == s);
+  CHECK(msg.count == 0);
+
+  // Header bytes below 0x20
+  const std::string bad = std::string("\x20\x1F") + "x";
+  CHECK(zza2Parse(bad.data(), bad.data() + bad.size(), msg) == nullptr);
+}
+
+
+// Fields are cut to 223 bytes at a UTF-8 character boundary, a buffer that is too small gives 0
+TEST(zza2, limits)
+{
+  std::string text;
+  for (uint8_t k = 0; k < 150; k++){
+    text += "ä";
+  }
+  std::string s = "ZZAMSG#D01#T0#######" + text + "###";
+  ZZAMsg msg;
+  CHECK(zzaParse(s.data(), s.size(), "", msg));
+  CHECK(msg.field[ZZAF_MESSAGE].len == 300);
+  char out[512];
+  size_t n = zza2Encode(msg, out, sizeof(out));
+  ZZAMsg v2;
+  CHECK(zza2Parse(out + 2, out + n, v2) == out + n);
+  CHECK(v2.field[ZZAF_MESSAGE].len == 222);
+  CHECK(memcmp(v2.field[ZZAF_MESSAGE].ptr, text.data(), 222) == 0);
+
+  std::string ascii(300, 'x');
+  s = "ZZAMSG#D01#T0#######" + ascii + "###";
+  CHECK(zzaParse(s.data(), s.size(), "", msg));
+  n = zza2Encode(msg, out, sizeof(out));
+  CHECK(zza2Parse(out + 2, out + n, v2) == out + n);
+  CHECK(v2.field[ZZAF_MESSAGE].len == 223);
+
+  CHECK(zza2Encode(msg, out, 2) == 0);
+  CHECK(zza2Encode(msg, out, 20) == 0);
+  // Magic and version, D01, T0 and 223 bytes message need 236 bytes and the null
+  CHECK(zza2Encode(msg, out, 236) == 0);
+  CHECK(zza2Encode(msg, out, 237) == 236);
+}